@@ -3,11 +3,12 @@
 
 #include <vector>
 #include "graph.h"
+#include "solver_options.h"
 
 class abstract_solver {
 public:
-    explicit abstract_solver(const graph_t& graph, int crossing_number = 0)
-        : crossing_number(crossing_number), graph(graph) {}
+    explicit abstract_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : crossing_number(crossing_number), graph(graph), options(options) {}
 
     virtual bool solve() = 0;
 
@@ -15,9 +16,12 @@ public:
 
     std::vector<vertex_t> vertex_order;
     int crossing_number;
+    // Calls of the decision procedure made by solve(), for solvers that have one
+    int oracle_calls = 0;
 
 protected:
     const graph_t& graph;
+    const solver_options_t options;
 };
 
 #endif //OKP_RECOGNITION_SOLVER_H
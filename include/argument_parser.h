@@ -21,13 +21,27 @@ public:
 
     std::string input_graph;
     std::string output_file;
+    std::string batch_file;
+    int threads;
     solver_type method;
+    dp_arrangements_t dp_arrangements;
+    sat_cardinality_t sat_cardinality;
+    search_strategy_t search_strategy;
+    ilp_transitivity_t ilp_transitivity;
+    ilp_crossings_t ilp_crossings;
+    bool exact_crossings;
+    bool crossing_sum_objective;
+    int heuristic_moves;
+    bool kernelize;
     bool no_bct_decomposition;
+    bool no_symmetry_breaking;
+    bool split_pairs;
 
 private:
     boost::program_options::variables_map var_map{};
     boost::program_options::options_description opt_conf{
-        "Usage:\n\tokp-recognition[-exact|-obj|-exact-obj] <input_graph> [options]\n"
+        "Usage:\n\tokp-recognition <input_graph> [options]\n"
+        "\tokp-recognition --batch <graphs_file> [options]\n"
         "Allowed options"
     };
     boost::program_options::positional_options_description popt_conf{};
@@ -3,7 +3,14 @@
 
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/graph/biconnected_components.hpp>
+#include <atomic>
+#include <exception>
+#include <list>
+#include <ranges>
 #include "abstract_solver.h"
+#include "graph_view.h"
+#include "lower_bound.h"
+#include "thread_pool.h"
 
 enum bctree_node_type_t {
     B_NODE, C_NODE
@@ -11,8 +18,7 @@ enum bctree_node_type_t {
 
 struct bctree_vertex_t {
     bctree_node_type_t node_type;
-    graph_t bi_component;
-    std::vector<vertex_t> original_vertices;
+    graph_view_t bi_component;
     vertex_t articulation_point;
 };
 
@@ -22,8 +28,8 @@ typedef bctree_t::vertex_descriptor bctree_vertex;
 template <class sub_solver>
 class bicomponent_solver : public abstract_solver {
 public:
-    explicit bicomponent_solver(const graph_t& graph, int crossing_number = 0)
-        : abstract_solver(graph, crossing_number) {}
+    explicit bicomponent_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : abstract_solver(graph, crossing_number, options) {}
 
     bool solve() override {
         vertex_order.clear();
@@ -32,67 +38,174 @@ public:
             return true;
         }
 
-        bool ok = true;
-        dfs_visitor visitor(vertex_order, crossing_number, ok);
-
         bctree_t bctree = decompose(graph);
+        std::vector<block_solution_t> solutions(num_vertices(bctree));
+        if (!solve_blocks(bctree, solutions)) { return false; }
+
+        bool ok = true;
+        std::list<vertex_t> merged_order;
+        std::vector<std::list<vertex_t>::iterator> positions(num_vertices(graph), merged_order.end());
+        std::vector<bctree_vertex> predecessors(num_vertices(bctree), bctree_t::null_vertex());
+        merge_visitor visitor(merged_order, positions, predecessors, solutions, ok);
         std::vector<boost::default_color_type> color_map(num_vertices(bctree));
         auto color = make_iterator_property_map(color_map.begin(), get(boost::vertex_index, bctree));
-
         depth_first_search(bctree, visitor, color, 0);
+        vertex_order.assign(merged_order.begin(), merged_order.end());
         return ok;
     }
 
 private:
-    class dfs_visitor : public boost::default_dfs_visitor {
-        int& crossing_number;
-        std::vector<vertex_t>& vertex_order;
-        std::map<bctree_vertex, bctree_vertex> predecessors;
+    // Drawing of a B-node, the order is given by the vertices of the whole graph
+    struct block_solution_t {
+        bool solved = false;
+        int crossing_number = 0;
+        int oracle_calls = 0;
+        std::vector<vertex_t> vertex_order;
+    };
+
+    /*
+     * The blocks are independent, so they are solved in parallel, the largest
+     * ones first. With several blocks every one of them runs on a single
+     * thread, a single block gets all the threads of the solver. The crossing
+     * number is the largest one of the blocks, so a block only has to be
+     * drawn with the largest crossing number known to be needed: every block
+     * starts its search at the largest lower bound of all the blocks, raised
+     * by the crossing number of every finished block. A linear search only
+     * shares the crossing numbers of the finished blocks, so it keeps
+     * starting from the known crossing number instead of a lower bound.
+     */
+    bool solve_blocks(const bctree_t& tree, std::vector<block_solution_t>& solutions) {
+        std::vector<bctree_vertex> blocks;
+        for (bctree_vertex node : boost::make_iterator_range(vertices(tree))) {
+            if (tree[node].node_type == B_NODE) { blocks.push_back(node); }
+        }
+        std::ranges::stable_sort(blocks, std::greater<>(), [&tree](bctree_vertex node) {
+            return tree[node].bi_component.num_edges();
+        });
+
+        int initial_bound = crossing_number;
+        for (bctree_vertex node : blocks) {
+            if (options.search_strategy != LINEAR_SEARCH && !is_trivial(tree[node].bi_component)) {
+                initial_bound = std::max(initial_bound, local_crossing_lower_bound(tree[node].bi_component));
+            }
+        }
+        std::atomic<int> known_crossing_number = initial_bound;
+
+        solver_options_t block_options = options;
+        if (blocks.size() > 1) { block_options.threads = 1; }
+        std::atomic<bool> failed = false;
+        std::vector<std::exception_ptr> errors(blocks.size());
+        thread_pool pool(blocks.size() > 1 ? options.threads : 1);
+        pool.parallel_for(blocks.size(), [&](size_t index, int) {
+            if (failed) { return; }
+            block_solution_t& solution = solutions[blocks[index]];
+            try {
+                solve_block(tree, blocks[index], known_crossing_number, block_options, solution);
+            } catch (...) {
+                errors[index] = std::current_exception();
+            }
+            if (!solution.solved) {
+                failed = true;
+                return;
+            }
+            int known = known_crossing_number;
+            while (known < solution.crossing_number &&
+                   !known_crossing_number.compare_exchange_weak(known, solution.crossing_number)) {}
+        });
+        for (const std::exception_ptr& error : errors) {
+            if (error) { std::rethrow_exception(error); }
+        }
+        if (failed) { return false; }
+
+        crossing_number = 0;
+        for (bctree_vertex node : blocks) {
+            crossing_number = std::max(crossing_number, solutions[node].crossing_number);
+            oracle_calls += solutions[node].oracle_calls;
+        }
+        return true;
+    }
+
+    // Blocks drawn without crossings without any solver: single edges, triangles and cycles
+    static bool is_trivial(const graph_view_t& block) {
+        return block.num_vertices() <= 3 || block.num_edges() == block.num_vertices();
+    }
+
+    void solve_block(const bctree_t& tree, bctree_vertex node, int start, const solver_options_t& block_options,
+                     block_solution_t& solution) const {
+        const graph_view_t& block = tree[node].bi_component;
+        if (is_trivial(block)) {
+            // The cycle in the order of a walk along it
+            solution.solved = true;
+            int previous = 0;
+            int current = 0;
+            do {
+                solution.vertex_order.push_back(block.global_vertex(current));
+                for (int next : block.neighbours(current)) {
+                    if (next != previous || block.num_vertices() == 2) {
+                        previous = std::exchange(current, next);
+                        break;
+                    }
+                }
+            } while (current != 0 && static_cast<int>(solution.vertex_order.size()) < block.num_vertices());
+            return;
+        }
+
+        // Only the block being solved is expanded into a graph_t
+        graph_t block_graph = block.to_graph();
+        sub_solver component_solver(block_graph, start, block_options);
+        solution.solved = component_solver.solve();
+        solution.crossing_number = component_solver.crossing_number;
+        solution.oracle_calls = component_solver.oracle_calls;
+        if (!solution.solved) { return; }
+
+        solution.vertex_order = std::move(component_solver.vertex_order);
+        std::ranges::transform(solution.vertex_order, solution.vertex_order.begin(),
+                               [&block, &block_graph](vertex_t v) {
+                                   return block.global_vertex(static_cast<int>(get(boost::vertex_index, block_graph, v)));
+                               });
+    }
+
+    // Inserts the drawings of the blocks next to the articulation points, in the DFS order of the tree.
+    // The order is a list with the position of every vertex, so every block is inserted in linear time.
+    class merge_visitor : public boost::default_dfs_visitor {
+        std::list<vertex_t>& merged_order;
+        std::vector<std::list<vertex_t>::iterator>& positions;
+        std::vector<bctree_vertex>& predecessors;
+        std::vector<block_solution_t>& solutions;
         bool& ok;
 
     public:
-        dfs_visitor(std::vector<vertex_t>& vertex_order, int& crossing_number, bool& ok)
-            : crossing_number(crossing_number), vertex_order(vertex_order), ok(ok) {}
+        merge_visitor(std::list<vertex_t>& merged_order, std::vector<std::list<vertex_t>::iterator>& positions,
+                      std::vector<bctree_vertex>& predecessors, std::vector<block_solution_t>& solutions, bool& ok)
+            : merged_order(merged_order), positions(positions), predecessors(predecessors), solutions(solutions),
+              ok(ok) {}
 
         void discover_vertex(bctree_vertex node, const bctree_t& tree) {
             if (!ok) { return; }
 
             if (tree[node].node_type == C_NODE) { return; }
-            sub_solver component_solver(tree[node].bi_component, crossing_number);
-            ok = component_solver.solve();
-
-            if (!ok) { return; }
-
-            std::vector<vertex_t>& component_order = component_solver.vertex_order;
+            std::vector<vertex_t>& component_order = solutions[node].vertex_order;
 
-            typedef boost::property_map<graph_t, boost::vertex_index_t>::const_type vertex_index_map_t;
-            vertex_index_map_t component_index_map = get(boost::vertex_index, tree[node].bi_component);
-            std::transform(component_order.begin(), component_order.end(), component_order.begin(),
-                           [&tree, &node, &component_index_map](const vertex_t& v) {
-                               return tree[node].original_vertices[get(component_index_map, v)];
-                           });
-
-            if (vertex_order.empty()) {
-                vertex_order.insert(vertex_order.end(), component_order.begin(), component_order.end());
-                crossing_number = component_solver.crossing_number;
+            if (merged_order.empty()) {
+                for (vertex_t v : component_order) { positions[v] = merged_order.insert(merged_order.end(), v); }
                 return;
             }
 
-            auto cut_node = predecessors.find(node);
-            if (cut_node == predecessors.end()) {
-                std::cout << "Can not find predecessor!!" << std::endl;
+            bctree_vertex cut_node = predecessors[node];
+            if (cut_node == bctree_t::null_vertex()) {
+                std::cerr << "Can not find predecessor!!" << std::endl;
                 ok = false;
                 return;
             }
 
-            vertex_t articulation_point = tree[cut_node->second].articulation_point;
+            vertex_t articulation_point = tree[cut_node].articulation_point;
             auto rotate_iter = std::ranges::find(component_order, articulation_point);
             std::ranges::rotate(component_order, rotate_iter);
 
-            auto insert_iter = ++std::ranges::find(vertex_order, articulation_point);
-            vertex_order.insert(insert_iter, ++component_order.begin(), component_order.end());
-
-            crossing_number = std::max(component_solver.crossing_number, crossing_number);
+            auto insert_iter = std::next(positions[articulation_point]);
+            for (vertex_t v : component_order | std::views::drop(1)) {
+                positions[v] = merged_order.insert(insert_iter, v);
+            }
         }
 
         void tree_edge(const edge_t& edge, const bctree_t& graph) {
@@ -115,7 +228,7 @@ private:
         bctree_t tree;
 
         std::vector<bctree_vertex> b_nodes;
-        std::unordered_map<vertex_t, bctree_vertex> c_nodes;
+        std::vector<bctree_vertex> c_nodes(num_vertices(graph), bctree_t::null_vertex());
         for (int i = 0; i < num_components; ++i) {
             bctree_vertex node = add_vertex(tree);
             tree[node].node_type = B_NODE;
@@ -125,46 +238,42 @@ private:
             bctree_vertex node = add_vertex(tree);
             tree[node].node_type = C_NODE;
             tree[node].articulation_point = articulation_point;
-            c_nodes.insert({articulation_point, node});
+            c_nodes[articulation_point] = node;
         }
 
-        std::vector<std::unordered_map<vertex_t, vertex_t>> vertex_mappings(num_components);
-        for (auto [ei, ei_end] = edges(graph); ei != ei_end; ++ei) {
-            int component_id = edge_component[get(edge_index_map, *ei)];
-            bctree_vertex b_node = b_nodes[component_id];
-            auto& component = tree[b_node].bi_component;
-            vertex_t source = boost::source(*ei, graph);
-            vertex_t target = boost::target(*ei, graph);
-
-            auto& vertex_mapping = vertex_mappings[component_id];
-            if (!vertex_mapping.contains(source)) {
-                vertex_mapping.insert({source, add_vertex(component)});
-                if (c_nodes.contains(source)) {
-                    add_edge(b_node, c_nodes[source], tree);
-                }
-            }
-            if (!vertex_mapping.contains(target)) {
-                vertex_mapping.insert({target, add_vertex(component)});
-                if (c_nodes.contains(target)) {
-                    add_edge(b_node, c_nodes[target], tree);
-                }
-            }
-
-            add_edge(vertex_mapping[source], vertex_mapping[target], static_cast<int>(num_edges(component)), component);
+        // Edges grouped by their component, each group in the order of edges(graph)
+        std::vector<int> component_offsets(num_components + 1, 0);
+        for (int component_id : edge_component) { ++component_offsets[component_id + 1]; }
+        for (int component_id = 0; component_id < num_components; ++component_id) {
+            component_offsets[component_id + 1] += component_offsets[component_id];
+        }
+        std::vector<edge_t> component_edges(num_edges(graph));
+        std::vector<int> next_edge(component_offsets.begin(), component_offsets.end() - 1);
+        for (edge_t edge : boost::make_iterator_range(edges(graph))) {
+            component_edges[next_edge[edge_component[get(edge_index_map, edge)]]++] = edge;
         }
 
+        // Local vertices are numbered in the order of their first edge
+        std::vector<int> local_index(num_vertices(graph), -1);
         for (int component_id = 0; component_id < num_components; ++component_id) {
-            typedef boost::property_map<graph_t, boost::vertex_index_t>::type vertex_index_map_t;
-
-            const graph_t& component = tree[b_nodes[component_id]].bi_component;
-            vertex_index_map_t vertex_index_map = get(boost::vertex_index, component);
-            std::vector<vertex_t>& backwards_mapping = tree[b_nodes[component_id]].original_vertices;
-            backwards_mapping.resize(num_vertices(component));
-
-            for (const auto& [global_v, local_v] : vertex_mappings[component_id]) {
-                int local_v_index = static_cast<int>(get(vertex_index_map, local_v));
-                backwards_mapping[local_v_index] = global_v;
+            bctree_vertex b_node = b_nodes[component_id];
+            std::vector<vertex_t> global_vertices;
+            std::vector<std::pair<int, int>> local_edges;
+            auto local_vertex = [&](vertex_t v) {
+                if (local_index[v] < 0) {
+                    local_index[v] = static_cast<int>(global_vertices.size());
+                    global_vertices.push_back(v);
+                    if (c_nodes[v] != bctree_t::null_vertex()) { add_edge(b_node, c_nodes[v], tree); }
+                }
+                return local_index[v];
+            };
+            for (int i = component_offsets[component_id]; i < component_offsets[component_id + 1]; ++i) {
+                int source = local_vertex(boost::source(component_edges[i], graph));
+                int target = local_vertex(boost::target(component_edges[i], graph));
+                local_edges.emplace_back(source, target);
             }
+            for (vertex_t v : global_vertices) { local_index[v] = -1; }
+            tree[b_node].bi_component = graph_view_t(std::move(global_vertices), std::move(local_edges));
         }
 
         return tree;
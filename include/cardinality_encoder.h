@@ -0,0 +1,49 @@
+#ifndef OKP_RECOGNITION_CARDINALITY_ENCODER_H
+#define OKP_RECOGNITION_CARDINALITY_ENCODER_H
+
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <utility>
+#include <vector>
+#include "solver_options.h"
+
+/*
+ * Encodes "at most bound of the literals are true" into CNF. The clauses are
+ * passed literal by literal to the sink, each one closed by 0, and are all
+ * guarded by the activation literal if it is nonzero. Auxiliary variables are
+ * numbered after variable_count, which is advanced accordingly. Only the
+ * clauses propagating towards the counter outputs are generated, this is
+ * enough for an upper bound.
+ */
+class cardinality_encoder {
+public:
+    cardinality_encoder(std::function<void(int)> sink, int false_literal)
+        : sink(std::move(sink)), false_literal(false_literal) {}
+
+    void at_most(sat_cardinality_t encoding, std::span<const int> literals, int bound,
+                 int activation, int& variable_count);
+
+private:
+    void add_clause(std::initializer_list<int> literals);
+
+    void binomial(std::span<const int> literals, int bound);
+    void sequential_counter(std::span<const int> literals, int bound);
+    // Unary outputs of the literals' sum, cut off at limit
+    std::vector<int> totalizer(std::span<const int> literals, int limit);
+
+    // Network of Asin et al., inputs of the merges have equal power of two sizes
+    std::pair<int, int> comparator(int a, int b);
+    std::vector<int> half_merge(const std::vector<int>& a, const std::vector<int>& b);
+    std::vector<int> half_sort(const std::vector<int>& a);
+    std::vector<int> simplified_merge(const std::vector<int>& a, const std::vector<int>& b);
+    // Largest limit values of the inputs sorted decreasingly, limit is a power of two dividing the size
+    std::vector<int> cardinality_network(const std::vector<int>& a, int limit);
+
+    const std::function<void(int)> sink;
+    const int false_literal;
+    int activation = 0;
+    int* variable_count = nullptr;
+};
+
+#endif //OKP_RECOGNITION_CARDINALITY_ENCODER_H
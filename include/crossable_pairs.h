@@ -0,0 +1,35 @@
+#ifndef OKP_RECOGNITION_CROSSABLE_PAIRS_H
+#define OKP_RECOGNITION_CROSSABLE_PAIRS_H
+
+#include <span>
+#include <utility>
+#include <vector>
+#include "graph.h"
+
+/*
+ * The pairs of edges that can cross in an outer drawing, i.e. those without
+ * a common end, numbered 0, ..., size() - 1. The encodings give every pair
+ * one crossing variable and find the pairs of an edge in CSR form, instead
+ * of an m x m matrix with variables for adjacent edges that never cross.
+ */
+class crossable_pairs_t {
+public:
+    crossable_pairs_t() = default;
+    explicit crossable_pairs_t(const graph_t& graph);
+
+    int size() const { return static_cast<int>(pairs.size()); }
+    // The first edge of a pair has the smaller edge index
+    const std::pair<edge_t, edge_t>& edges(int pair) const { return pairs[pair]; }
+    // Pairs containing the edge with the given index, by increasing index of the other edge
+    std::span<const int> pairs_of(int edge_index) const {
+        return {edge_pairs.data() + offsets[edge_index], edge_pairs.data() + offsets[edge_index + 1]};
+    }
+
+private:
+    std::vector<std::pair<edge_t, edge_t>> pairs;
+    // Pairs of edge e are edge_pairs[offsets[e]], ..., edge_pairs[offsets[e + 1] - 1]
+    std::vector<int> offsets;
+    std::vector<int> edge_pairs;
+};
+
+#endif //OKP_RECOGNITION_CROSSABLE_PAIRS_H
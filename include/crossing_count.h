@@ -0,0 +1,47 @@
+#ifndef OKP_RECOGNITION_CROSSING_COUNT_H
+#define OKP_RECOGNITION_CROSSING_COUNT_H
+
+#include <span>
+#include <utility>
+#include <vector>
+
+// Chord between two positions on a circle, the order of its ends does not matter
+typedef std::pair<int, int> chord_t;
+
+// Whether the ends of two chords strictly interleave. Chords with a common end do not cross.
+inline bool chords_cross(chord_t chord, chord_t other) {
+    if (chord.first > chord.second) { std::swap(chord.first, chord.second); }
+    if (other.first > other.second) { std::swap(other.first, other.second); }
+    return (chord.first < other.first && other.first < chord.second && chord.second < other.second) ||
+        (other.first < chord.first && chord.first < other.second && other.second < chord.second);
+}
+
+/*
+ * Counts for every chord of a set how many other chords of the set it
+ * crosses. Small sets are compared pairwise in a branchless loop the compiler
+ * can vectorise; larger ones are swept with a Fenwick tree in O(m log m).
+ * The buffers are kept between calls, so one counter should be reused.
+ */
+class crossing_counter {
+public:
+    // Stores the number of crossings of chords[i] in counts[i]
+    void count(std::span<const chord_t> chords, std::span<int> counts);
+
+    // Sets up to this size are compared pairwise
+    static constexpr size_t pairwise_limit = 48;
+
+private:
+    void count_pairwise(std::span<int> counts);
+    void count_sweep(std::span<int> counts);
+    // Fills order with the chord indices sorted by the given ends
+    void sort_by_position(const std::vector<int>& keys, int range);
+
+    // Ends of the chords, low[i] < high[i] unless the chord is a loop
+    std::vector<int> low;
+    std::vector<int> high;
+    std::vector<int> positions;
+    std::vector<int> order;
+    std::vector<int> fenwick;
+};
+
+#endif //OKP_RECOGNITION_CROSSING_COUNT_H
@@ -0,0 +1,21 @@
+#ifndef OKP_RECOGNITION_CROSSING_PATTERNS_H
+#define OKP_RECOGNITION_CROSSING_PATTERNS_H
+
+#include <array>
+
+/*
+ * Orders a, b, c, d of the ends u, v, s, t of two edges uv and st (as indices
+ * 0, 1, 2, 3) with a before b before c before d. In the first ones the edges
+ * cross, in the others they do not. sat_solver and ilp_solver link the
+ * crossing variable of the pair to the order variables with one clause or
+ * constraint per pattern.
+ */
+constexpr std::array<std::array<int, 4>, 8> crossing_patterns{{
+    {0, 2, 1, 3}, {0, 3, 1, 2}, {1, 2, 0, 3}, {1, 3, 0, 2}, {2, 0, 3, 1}, {3, 0, 2, 1}, {2, 1, 3, 0}, {3, 1, 2, 0}
+}};
+constexpr std::array<std::array<int, 4>, 16> non_crossing_patterns{{
+    {0, 1, 2, 3}, {0, 2, 3, 1}, {2, 3, 0, 1}, {2, 0, 1, 3}, {1, 0, 2, 3}, {1, 2, 3, 0}, {2, 3, 1, 0}, {2, 1, 0, 3},
+    {0, 1, 3, 2}, {0, 3, 2, 1}, {3, 2, 0, 1}, {3, 0, 1, 2}, {1, 0, 3, 2}, {1, 3, 2, 0}, {3, 2, 1, 0}, {3, 1, 0, 2}
+}};
+
+#endif //OKP_RECOGNITION_CROSSING_PATTERNS_H
@@ -0,0 +1,23 @@
+#ifndef OKP_RECOGNITION_CROSSING_SEARCH_H
+#define OKP_RECOGNITION_CROSSING_SEARCH_H
+
+#include <functional>
+#include <vector>
+#include "graph.h"
+#include "solver_options.h"
+
+/*
+ * Finds the smallest crossing number for which the decision oracle
+ * is_drawable succeeds, assuming it fails below and succeeds above that
+ * number. upper_bound is known to be drawable (e.g. from an existing
+ * drawing), so the oracle is only called for smaller values and upper_bound
+ * is returned if all of them fail. Linear search starts at start, the other
+ * strategies at max(start, lower_bound).
+ */
+int search_crossing_number(search_strategy_t strategy, int start, int lower_bound, int upper_bound,
+                           const std::function<bool(int)>& is_drawable);
+
+// Largest number of crossings on an edge when the vertices are placed on a circle in the given order
+int local_crossing_number(const graph_t& graph, const std::vector<vertex_t>& order);
+
+#endif //OKP_RECOGNITION_CROSSING_SEARCH_H
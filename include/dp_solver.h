@@ -2,9 +2,22 @@
 #define OKP_RECOGNITION_OKP_SOLVER_H
 
 
+#include <ranges>
+#include <span>
+#include <type_traits>
 #include "abstract_solver.h"
+#include "crossing_count.h"
+#include "flat_hash_set.hpp"
+#include "thread_pool.h"
+#include "vertex_set.hpp"
 
-class dp_solver : public abstract_solver {
+/*
+ * Dynamic program over the sides of links. Sides are stored as vertex_set_t
+ * bitmasks, so the solver handles graphs with up to
+ * vertex_set_traits<vertex_set_t>::capacity vertices.
+ */
+template <class vertex_set_t>
+class basic_dp_solver : public abstract_solver {
     typedef boost::property_map<graph_t, boost::edge_index_t>::const_type edge_index_map_t;
     typedef boost::property_map<graph_t, boost::vertex_index_t>::const_type vertex_index_map_t;
 
@@ -12,8 +25,8 @@ class dp_solver : public abstract_solver {
     const edge_index_map_t edge_index_map;
 
 public:
-    explicit dp_solver(const graph_t& graph, int crossing_number = 0)
-        : abstract_solver(graph, crossing_number),
+    explicit basic_dp_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : abstract_solver(graph, crossing_number, options),
           vertex_index_map(get(boost::vertex_index, graph)),
           edge_index_map(get(boost::edge_index, graph)),
           filtered_graph(graph, [&](const edge_t& v) {
@@ -22,20 +35,129 @@ public:
                              return active_link.first != get(vertex_index_map, v)
                                     && active_link.second != get(vertex_index_map, v);
                          }),
-          active_link(graph_t::null_vertex(), graph_t::null_vertex()),
-          triangle_edges_map(num_edges(graph)),
-          edges_intersection_count(num_edges(graph), 0) {
-        triangle_edges.reserve(num_edges(graph));
-    }
+          active_link(graph_t::null_vertex(), graph_t::null_vertex()) {}
 
     bool solve() override;
 
+    // Each piercing edge of a cell contributes one byte for its position and one
+    // for its crossing count, so the packed words describe up to 8 piercing edges.
+    static constexpr int max_packed_edges = 8;
+
+    typedef std::vector<std::pair<int, int>> wide_edges_pool_t;
+
+    // Order of the piercing edges of a table entry with their crossing counts,
+    // packed into 128 bits. Also serves as the deduplication key of a cell.
+    // Orders of more than max_packed_edges edges, or with values that do not
+    // fit into a byte, are rare. They are appended to a pool of wide edges
+    // instead and the signature keeps their range within the pool.
+    struct edge_order_signature_t {
+        uint64_t words[2] = {0, 0};
+        uint32_t wide_begin = 0;
+        uint32_t wide_size = 0;
+
+        static edge_order_signature_t pack(const std::ranges::sized_range auto& edge_order, wide_edges_pool_t& pool) {
+            edge_order_signature_t signature;
+            bool fits = std::ranges::size(edge_order) <= max_packed_edges;
+            for (auto [first, second] : edge_order) { fits = fits && first <= 0xFF && second <= 0xFF; }
+            if (!fits) {
+                signature.wide_begin = static_cast<uint32_t>(pool.size());
+                signature.wide_size = static_cast<uint32_t>(std::ranges::size(edge_order));
+                pool.insert(pool.end(), std::ranges::begin(edge_order), std::ranges::end(edge_order));
+                return signature;
+            }
+            int position = 0;
+            for (auto [first, second] : edge_order) {
+                uint64_t packed = static_cast<uint64_t>(first) | static_cast<uint64_t>(second) << 8;
+                signature.words[position / 4] |= packed << 16 * (position % 4);
+                ++position;
+            }
+            return signature;
+        }
+
+        std::pair<int, int> get(int position, const wide_edges_pool_t& pool) const {
+            if (wide_size != 0) { return pool[wide_begin + position]; }
+            uint64_t packed = words[position / 4] >> 16 * (position % 4);
+            return {static_cast<int>(packed & 0xFF), static_cast<int>(packed >> 8 & 0xFF)};
+        }
+
+        std::span<const std::pair<int, int>> wide_edges(const wide_edges_pool_t& pool) const {
+            return {pool.data() + wide_begin, wide_size};
+        }
+    };
+
+    // Signature with the pool holding its wide edges, so the signatures of the
+    // tables and those a worker found in the current level compare by contents
+    struct signature_key_t {
+        edge_order_signature_t signature;
+        const wide_edges_pool_t* pool = nullptr;
+
+        bool operator==(const signature_key_t& other) const {
+            return signature.words[0] == other.signature.words[0] && signature.words[1] == other.signature.words[1] &&
+                std::ranges::equal(signature.wide_edges(*pool), other.signature.wide_edges(*other.pool));
+        }
+    };
+
+    struct signature_key_hash_t {
+        size_t operator()(const signature_key_t& key) const {
+            uint64_t hash = key.signature.words[0] * 0x9E3779B97F4A7C15ULL ^ key.signature.words[1];
+            for (auto [first, second] : key.signature.wide_edges(*key.pool)) {
+                hash = hash * 0x9E3779B97F4A7C15ULL ^
+                    (static_cast<uint64_t>(first) << 32 | static_cast<uint32_t>(second));
+            }
+            hash ^= hash >> 29;
+            hash *= 0xBF58476D1CE4E5B9ULL;
+            return hash ^ hash >> 32;
+        }
+    };
+
+    // Fixed-size record of a dp_table cell. Instead of a vertex order it keeps
+    // the split vertex and the entries of both parts it was combined from, so
+    // the order is restored only once for the entry that solves the graph.
     struct table_entry_t {
-        std::vector<std::pair<int, int>> edge_order;
-        std::vector<vertex_t> vertex_order;
+        edge_order_signature_t edge_order;
+        vertex_t split_vertex = graph_t::null_vertex();
+        size_t part_a_entry = 0;
+        size_t part_b_entry = 0;
+    };
+    static_assert(std::is_trivially_copyable_v<table_entry_t>);
+
+    // Contiguous block of entries within table_entries
+    struct entry_range_t {
+        size_t begin;
+        size_t size;
+    };
+
+    // Cell of dp_table. Every crossing number iteration that finds new entries
+    // for the cell appends one block; the cut-off range lists the candidates of
+    // the cell rejected by the current crossing number.
+    struct table_cell_t {
+        std::vector<entry_range_t> entries;
+        size_t cut_off_begin = 0;
+        size_t cut_off_size = 0;
+    };
+
+    // Contiguous block of piercing edges within piercing_edges_pool
+    struct edge_range_t {
+        size_t begin;
+        size_t size;
+    };
+
+    // Pair of part entries with a split vertex of which at least one arrangement
+    // exceeded the crossing number. exceeded_count is the smallest count seen
+    // above the bound, the candidate is not worth retrying for a lower one.
+    struct cut_off_candidate_t {
+        vertex_t split_vertex;
+        edge_range_t part_a_edges;
+        size_t part_a_entry;
+        edge_range_t part_b_edges;
+        size_t part_b_entry;
+        int exceeded_count;
     };
 
 private:
+    typedef vertex_set_traits<vertex_set_t> traits;
+    typedef std::pair<std::pair<vertex_set_t, int>, std::pair<vertex_set_t, int>> cluster_sides_t;
+
     enum triangle_vertex_type_t {
         LINK_SRC      = 0,
         HELPER_PART_A = 1,
@@ -46,59 +168,135 @@ private:
         NONE          = 6
     };
 
+    typedef std::pair<triangle_vertex_type_t, int> triangle_vertex_t;
+    typedef std::pair<triangle_vertex_t, triangle_vertex_t> triangle_edge_t;
+
+    // Scratch space of one thread filling cells, and the entries and cut-off
+    // candidates it found. Those of a cell are contiguous in the buffers and
+    // are moved into the shared arenas once the whole level is done.
+    struct worker_t {
+        std::pair<vertex_t, vertex_t> active_link;
+        std::vector<edge_t> part_a_edges_order;
+        std::vector<edge_t> part_b_edges_order;
+        std::vector<edge_t> piercing_edges_order;
+        std::vector<std::pair<int, int>> combined_edge_order;
+        flat_hash_set<signature_key_t, signature_key_hash_t> cell_signatures;
+        std::vector<int> triangle_edges;
+        std::vector<triangle_edge_t> triangle_edges_map;
+        std::vector<int> edges_intersection_count;
+        // Chords of the triangle edges being counted and their crossings
+        std::vector<chord_t> triangle_chords;
+        std::vector<int> triangle_crossings;
+        crossing_counter crossings;
+        int min_exceeded_count = 0;
+        // Pruned enumeration: per piercing edge of the cell the other end of
+        // its triangle edge and its crossings with the edges that are not
+        // piercing. The edges leaving the parts are placed in a fixed order,
+        // arrangement_placed flags the piercing edges placed so far.
+        std::vector<triangle_vertex_t> arrangement_origins;
+        std::vector<int> arrangement_crossings;
+        std::vector<int> part_chains[2];
+        std::vector<int> split_edges;
+        std::vector<std::pair<int, int>> arrangement;
+        std::vector<bool> arrangement_placed;
+        std::vector<table_entry_t> entries;
+        // Wide edges of the signatures of entries, rebased into wide_edges_pool with them
+        wide_edges_pool_t wide_edges;
+        std::vector<cut_off_candidate_t> cut_off_candidates;
+#ifndef NDEBUG
+        size_t hits = 0;
+        size_t misses = 0;
+#endif
+    };
+
+    // Cell of the level being filled and where its worker put the results
+    struct level_cell_t {
+        int v_index;
+        int u_index;
+        vertex_set_t right_side;
+        int right_size;
+        edge_range_t piercing_edges;
+        table_cell_t* cell;
+        bool new_cell;
+        int worker = -1;
+        entry_range_t entries = {0, 0};
+        entry_range_t cut_off_candidates = {0, 0};
+    };
+
     std::pair<vertex_t, vertex_t> active_link;
-    std::vector<edge_t> part_a_edges_order;
-    std::vector<edge_t> part_b_edges_order;
-    std::vector<edge_t> piercing_edges_order;
-    table_entry_t combined_entry;
-    std::vector<std::vector<std::unordered_map<size_t, std::unordered_map<std::string, table_entry_t>>>> dp_table;
+    std::vector<worker_t> workers;
+    std::vector<std::vector<std::unordered_map<vertex_set_t, table_cell_t, typename traits::hash>>> dp_table;
+    std::vector<table_entry_t> table_entries;
+    wide_edges_pool_t wide_edges_pool;
+    // First entry found in the current crossing number iteration
+    size_t iteration_begin = 0;
+    std::vector<cut_off_candidate_t> cut_off_candidates;
+    std::vector<cut_off_candidate_t> previous_cut_off_candidates;
 
     typedef boost::filtered_graph<graph_t, boost::function<bool(edge_t)>, boost::function<bool(vertex_t)>>
     filtered_graph_t;
     filtered_graph_t filtered_graph;
     std::vector<edge_t> filtered_edges;
-    std::vector<std::vector<std::vector<std::unordered_map<size_t, std::vector<edge_t>>>>> dp_table_initialisation;
-
-    typedef std::pair<triangle_vertex_type_t, int> triangle_vertex_t;
-    typedef std::pair<triangle_vertex_t, triangle_vertex_t> triangle_edge_t;
-    std::vector<int> triangle_edges;
-    std::vector<triangle_edge_t> triangle_edges_map;
-    std::vector<int> edges_intersection_count;
+    typedef std::unordered_map<vertex_set_t, edge_range_t, typename traits::hash> side_edges_map_t;
+    // Right sides of every link by their size. The size lists only grow as
+    // far as sides exist, to keep the table small for graphs with many vertices.
+    std::vector<std::vector<std::vector<side_edges_map_t>>> dp_table_initialisation;
+    std::vector<edge_t> piercing_edges_pool;
 
 
     bool check_input();
+    // Replaces vertex_order by a drawing stored in the tables of a successful is_drawable call
+    bool restore_drawing();
+    std::span<const edge_t> range_edges(const edge_range_t& range) const;
+    const side_edges_map_t& right_sides(vertex_t v, vertex_t u, int size) const;
+    void fill_edge_order(std::vector<edge_t>& order_vector,
+                         std::span<const edge_t> edges,
+                         const edge_order_signature_t& edge_order) const;
     void static fill_edge_order(std::vector<edge_t>& order_vector,
-                                const std::vector<edge_t>& edges,
+                                std::span<const edge_t> edges,
                                 const std::vector<std::pair<int, int>>& edge_order);
-    void process_split(size_t right_side, int right_size, const std::vector<edge_t>& piercing_edges,
-                       vertex_t split_vertex);
-    void process_all_arrangements(const std::vector<edge_t>& piercing_edges,
-                                  vertex_t split_vertex, size_t right_side,
-                                  const table_entry_t& part_a_entry,
-                                  const table_entry_t& part_b_entry);
-    void combine_vertex_order(vertex_t split_vertex,
-                              const table_entry_t& part_a_entry,
-                              const table_entry_t& part_b_entry);
-    bool is_drawable();
+    void process_cell(worker_t& worker, level_cell_t& level_cell);
+    void process_split(worker_t& worker, const vertex_set_t& right_side, int right_size,
+                       std::span<const edge_t> piercing_edges, vertex_t split_vertex, bool new_cell);
+    void process_candidate(worker_t& worker, std::span<const edge_t> piercing_edges, vertex_t split_vertex,
+                           const edge_range_t& part_a_edges, size_t part_a_id,
+                           const edge_range_t& part_b_edges, size_t part_b_id);
+    // Returns false and drops the wide edges of the signature if the cell already has it
+    bool insert_signature(worker_t& worker, const edge_order_signature_t& signature);
+    int add_part_crossings(worker_t& worker, const table_entry_t& part_a_entry, const table_entry_t& part_b_entry);
+    void process_all_arrangements(worker_t& worker, std::span<const edge_t> piercing_edges, vertex_t split_vertex,
+                                  const table_entry_t& part_a_entry, size_t part_a_id,
+                                  const table_entry_t& part_b_entry, size_t part_b_id);
+    void process_pruned_arrangements(worker_t& worker, std::span<const edge_t> piercing_edges,
+                                     vertex_t split_vertex, size_t part_a_id, size_t part_b_id);
+    void place_arrangement_edge(worker_t& worker, int position, size_t chain_positions[2],
+                                vertex_t split_vertex, size_t part_a_id, size_t part_b_id);
+    void restore_vertex_order(std::vector<vertex_t>& order, std::pair<vertex_t, vertex_t> link,
+                              size_t entry_id, bool reversed) const;
+    bool is_drawable(thread_pool& pool);
 
 
+    void reset_table();
     void add_table_entries(int k);
     void initialise_table();
     void select_edges(filtered_graph_t::edge_iterator start, const filtered_graph_t::edge_iterator& end, int k);
     void fill_right_sides();
-    void populate_right_sides(std::vector<std::pair<std::pair<size_t, int>, std::pair<size_t, int>>>::iterator start,
-                              std::vector<std::pair<std::pair<size_t, int>, std::pair<size_t, int>>>::iterator end,
-                              size_t cur_side, int count);
+    void populate_right_sides(typename std::vector<cluster_sides_t>::iterator start,
+                              typename std::vector<cluster_sides_t>::iterator end,
+                              vertex_set_t cur_side, int count);
 
 
-    bool check_inner_triangle(vertex_t split_vertex);
-    bool check_triangle_consistency(const std::ranges::range auto& edges,
+    bool check_inner_triangle(worker_t& worker, vertex_t split_vertex);
+    chord_t triangle_chord(const triangle_edge_t& triangle_edge) const;
+    void count_triangle_crossings(worker_t& worker, const std::ranges::range auto& edge_indices);
+    bool check_triangle_consistency(worker_t& worker, const std::ranges::range auto& edges,
                                     triangle_vertex_type_t edge_type, triangle_vertex_type_t prev_type);
-    void add_triangle_edges(const std::ranges::range auto& edges,
+    void add_triangle_edges(worker_t& worker, const std::ranges::range auto& edges,
                             vertex_t opposite_vertex,
                             triangle_vertex_type_t opposite_type,
                             triangle_vertex_type_t common_type);
-    bool count_triangle_intersections(const std::ranges::range auto& part_a_edges,
+    bool count_triangle_intersections(worker_t& worker,
+                                      const std::ranges::range auto& part_a_edges,
                                       const std::ranges::range auto& part_b_edges,
                                       const std::ranges::range auto& piercing_edges,
                                       vertex_t split_vertex);
@@ -111,5 +309,27 @@ private:
 #endif
 };
 
+extern template class basic_dp_solver<uint64_t>;
+extern template class basic_dp_solver<unsigned __int128>;
+extern template class basic_dp_solver<wide_vertex_set<4>>;
+
+/*
+ * Runs basic_dp_solver with the narrowest vertex set type that fits the
+ * input graph, so small graphs keep using plain 64-bit masks.
+ */
+class dp_solver : public abstract_solver {
+public:
+    explicit dp_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : abstract_solver(graph, crossing_number, options) {}
+
+    bool solve() override;
+
+    static constexpr int max_vertices = vertex_set_traits<wide_vertex_set<4>>::capacity;
+
+private:
+    template <class vertex_set_t>
+    bool solve_with();
+};
+
 
 #endif //OKP_RECOGNITION_OKP_SOLVER_H
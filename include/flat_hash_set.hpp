@@ -0,0 +1,69 @@
+#ifndef OKP_RECOGNITION_FLAT_HASH_SET_H
+#define OKP_RECOGNITION_FLAT_HASH_SET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Open-addressing hash set with linear probing that keeps all the keys in one
+ * contiguous array. It is meant to be cleared and refilled many times: clear()
+ * only resets the slots used since the previous clear, so the cost of a clear
+ * does not depend on the largest size the set ever had.
+ */
+template <class key_t, class hash_t>
+class flat_hash_set {
+public:
+    // Returns true if the key was not present in the set before
+    bool insert(const key_t& key) {
+        if (2 * (count + 1) > slots.size()) { grow(); }
+        size_t slot = find_slot(key);
+        if (occupied[slot]) { return false; }
+        occupied[slot] = true;
+        slots[slot] = key;
+        used_slots.push_back(slot);
+        ++count;
+        return true;
+    }
+
+    bool contains(const key_t& key) const {
+        return !slots.empty() && occupied[find_slot(key)];
+    }
+
+    void clear() {
+        for (size_t slot : used_slots) { occupied[slot] = false; }
+        used_slots.clear();
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+
+private:
+    size_t find_slot(const key_t& key) const {
+        size_t mask = slots.size() - 1;
+        size_t slot = hash_t{}(key) & mask;
+        while (occupied[slot] && !(slots[slot] == key)) {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void grow() {
+        std::vector<key_t> old_slots(std::max<size_t>(16, 2 * slots.size()));
+        std::swap(slots, old_slots);
+        occupied.assign(slots.size(), false);
+        std::vector<size_t> old_used_slots;
+        std::swap(used_slots, old_used_slots);
+        count = 0;
+        for (size_t slot : old_used_slots) {
+            insert(old_slots[slot]);
+        }
+    }
+
+    std::vector<key_t> slots;
+    std::vector<uint8_t> occupied;
+    std::vector<size_t> used_slots;
+    size_t count = 0;
+};
+
+#endif //OKP_RECOGNITION_FLAT_HASH_SET_H
@@ -1,6 +1,7 @@
 #ifndef OKP_RECOGNITION_GRAPHIO_H
 #define OKP_RECOGNITION_GRAPHIO_H
 
+#include <istream>
 #include <vector>
 #include "graph.h"
 
@@ -11,4 +12,14 @@ void save_dot(const std::string& file_name, graph_t& graph,
 
 int count_edge_crossing(const edge_t& edge, const graph_t& graph);
 
+// Reads the next graph record from a stream containing either concatenated
+// Graphviz graphs (`graph G {...}strict graph {...}`) or one graph6 string per line.
+bool read_graph_record(std::istream& in, std::string& record);
+
+// Parses a record returned by read_graph_record into the given graph.
+void parse_graph_record(const std::string& record, graph_t& graph,
+                        boost::dynamic_properties& graph_props);
+
+void read_graph6(const std::string& graph6, graph_t& graph);
+
 #endif //OKP_RECOGNITION_GRAPHIO_H
@@ -0,0 +1,54 @@
+#ifndef OKP_RECOGNITION_GRAPH_KERNEL_H
+#define OKP_RECOGNITION_GRAPH_KERNEL_H
+
+#include <vector>
+#include "graph.h"
+#include "graph_view.h"
+
+/*
+ * Reductions that keep the local crossing number of the best outer drawing,
+ * applied before any solver, together with the steps to lift a drawing of
+ * the reduced graph back to the input graph:
+ *  - pendant vertices are removed until none is left, so pendant trees
+ *    disappear completely. A removed vertex is put next to its neighbour,
+ *    where its edge has no crossings.
+ *  - a chain u, v_1, ..., v_L, w of degree-2 vertices is shortened to
+ *    u, v_1, ..., v_T, w with T the number of the other vertices. In a
+ *    drawing with L > T, two chain vertices lie between the same two other
+ *    vertices, so they can be merged without adding crossings. Conversely
+ *    the removed vertices are put next to v_T on the side of w, where the
+ *    edge to w crosses exactly the edges that v_T w crossed.
+ * Only chains longer than the rest of the graph are shortened, e.g. long
+ * cycles with a few chords.
+ */
+class graph_kernel_t {
+public:
+    explicit graph_kernel_t(const graph_t& graph);
+
+    // The reduced graph, its local vertices know their vertex in the input graph
+    const graph_view_t& reduced() const { return kernel; }
+    // Circular order of the input graph from an order of the reduced one given by input vertices
+    std::vector<vertex_t> lift(const std::vector<vertex_t>& kernel_order) const;
+
+private:
+    struct pendant_t {
+        vertex_t vertex;
+        vertex_t neighbour;
+    };
+
+    // Chain shortened to v_T, the removed vertices v_{T+1}, ..., v_L are reinserted next to v_T
+    struct chain_t {
+        vertex_t last_kept;
+        vertex_t before_last_kept;
+        vertex_t end;
+        std::vector<vertex_t> removed;
+    };
+
+    int num_input_vertices;
+    graph_view_t kernel;
+    // Both in the order they were applied
+    std::vector<pendant_t> pendants;
+    std::vector<chain_t> chains;
+};
+
+#endif //OKP_RECOGNITION_GRAPH_KERNEL_H
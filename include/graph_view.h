@@ -0,0 +1,41 @@
+#ifndef OKP_RECOGNITION_GRAPH_VIEW_H
+#define OKP_RECOGNITION_GRAPH_VIEW_H
+
+#include <span>
+#include <utility>
+#include <vector>
+#include "graph.h"
+
+/*
+ * Compact read-only copy of a subgraph, e.g. a block of the BC-tree. The
+ * vertices are numbered 0, ..., n - 1 locally, the adjacency is stored in
+ * CSR form and every local vertex knows its vertex in the whole graph. It
+ * takes a few flat arrays instead of the per-vertex and per-edge allocations
+ * of a graph_t.
+ */
+class graph_view_t {
+public:
+    graph_view_t() = default;
+    // Edges are given by their local ends, edge i gets index i
+    graph_view_t(std::vector<vertex_t> global_vertices, std::vector<std::pair<int, int>> edges);
+
+    int num_vertices() const { return static_cast<int>(global_vertices.size()); }
+    int num_edges() const { return static_cast<int>(edges.size()); }
+    std::span<const int> neighbours(int v) const {
+        return {targets.data() + offsets[v], targets.data() + offsets[v + 1]};
+    }
+    vertex_t global_vertex(int v) const { return global_vertices[v]; }
+    const std::vector<std::pair<int, int>>& edge_ends() const { return edges; }
+
+    // The subgraph as a graph_t with edge indices, for the solvers
+    graph_t to_graph() const;
+
+private:
+    std::vector<vertex_t> global_vertices;
+    std::vector<std::pair<int, int>> edges;
+    // Neighbours of v are targets[offsets[v]], ..., targets[offsets[v + 1] - 1]
+    std::vector<int> offsets;
+    std::vector<int> targets;
+};
+
+#endif //OKP_RECOGNITION_GRAPH_VIEW_H
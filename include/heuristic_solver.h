@@ -0,0 +1,26 @@
+#ifndef OKP_RECOGNITION_HEURISTIC_SOLVER_H
+#define OKP_RECOGNITION_HEURISTIC_SOLVER_H
+
+#include <vector>
+#include "abstract_solver.h"
+
+/*
+ * Replaces order by a circular order of the vertices with few crossings per
+ * edge and returns its local crossing number. The best of the identity, a
+ * BFS and a DFS order is improved by barycentric reordering and then by
+ * simulated annealing on swaps of two vertices, options.heuristic_moves
+ * swaps per vertex. The result is an upper bound only, it is deterministic
+ * for a given graph.
+ */
+int heuristic_drawing(const graph_t& graph, const solver_options_t& options, std::vector<vertex_t>& order);
+
+// Fast answers without optimality guarantee, the crossing number is the one of heuristic_drawing
+class heuristic_solver : public abstract_solver {
+public:
+    explicit heuristic_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : abstract_solver(graph, crossing_number, options) {}
+
+    bool solve() override;
+};
+
+#endif //OKP_RECOGNITION_HEURISTIC_SOLVER_H
@@ -1,9 +1,11 @@
 #ifndef OKP_RECOGNITION_ILP_SOLVER_H
 #define OKP_RECOGNITION_ILP_SOLVER_H
 
+#include <array>
 #include <vector>
 #include <gurobi_c++.h>
 #include "abstract_solver.h"
+#include "symmetry_breaking.h"
 
 
 class ilp_solver : public abstract_solver {
@@ -14,8 +16,8 @@ class ilp_solver : public abstract_solver {
     const edge_index_map_t edge_index_map;
 
 public:
-    explicit ilp_solver(const graph_t& graph, int crossing_number = 0)
-        : abstract_solver(graph, crossing_number),
+    explicit ilp_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : abstract_solver(graph, crossing_number, options),
           vertex_index_map(get(boost::vertex_index, graph)),
           edge_index_map(get(boost::edge_index, graph)) {
         if (!gurobi_env) {
@@ -29,15 +31,40 @@ public:
     bool solve() override;
 
 private:
-    void initialise_model(GRBModel& model);
+    // Crossable pair of edges uv and st with the variable telling whether they cross
+    struct crossing_pair_t {
+        // u, v, s, t
+        std::array<int, 4> ends;
+        GRBVar do_cross;
+    };
+    // Adds the lazy transitivity and crossing constraints
+    class lazy_constraint_callback;
+
+    void initialise_model(GRBModel& model, int start_crossing_number);
     void setup_order_variables(GRBModel& model);
     void transitivity_constraints(GRBModel& model);
+    void symmetry_breaking_constraints(GRBModel& model);
     void setup_crossing_variables(GRBModel& model);
+    // Links the crossing variables to the order, specialised for options.exact_crossings
+    template <bool exact>
+    void crossing_constraints(GRBModel& model);
+    // The ends of the pair in the order of the pattern (indices into ends) force a crossing
+    GRBTempConstr crossing_constraint(const crossing_pair_t& pair, const std::array<int, 4>& pattern) const;
+    // The ends of the pair in the order of the pattern exclude a crossing
+    GRBTempConstr non_crossing_constraint(const crossing_pair_t& pair, const std::array<int, 4>& pattern) const;
 
     std::vector<GRBLinExpr> edge_crossing_numbers;
     std::vector<std::vector<GRBLinExpr>> order_variables;
+    // The variable "i before j" of every pair i < j, row by row
+    std::vector<GRBVar> before_variables;
+    std::vector<crossing_pair_t> crossing_pairs;
     GRBLinExpr crossing_upper_bound;
-    static inline std::unique_ptr<GRBEnv> gurobi_env = nullptr;
+    // Positions of the vertices in the MIP start
+    std::vector<int> start_positions;
+    order_symmetries_t symmetries;
+    // Gurobi environments must not be shared between threads, so every thread
+    // running ilp_solver starts its own one and keeps it until it exits.
+    static inline thread_local std::unique_ptr<GRBEnv> gurobi_env = nullptr;
 };
 
 #endif //OKP_RECOGNITION_ILP_SOLVER_H
@@ -0,0 +1,44 @@
+#ifndef OKP_RECOGNITION_INCREMENTAL_SAT_SOLVER_H
+#define OKP_RECOGNITION_INCREMENTAL_SAT_SOLVER_H
+
+#include "sat_solver.h"
+
+extern "C" {
+#include <ipasir.h>
+}
+
+/*
+ * Same encoding as sat_solver, but kept in one IPASIR solver (e.g. CaDiCaL)
+ * for all crossing numbers. The order and crossing clauses are added once;
+ * the local crossing bound of every call gets its own activation literal,
+ * which is assumed while solving and switched off for good by the next call.
+ * Clauses learnt for smaller bounds stay valid for the larger ones.
+ */
+class incremental_sat_solver : public sat_solver {
+    void* ipasir_solver;
+    int variable_count;
+    int bound_activation;
+
+public:
+    explicit incremental_sat_solver(const graph_t& graph, int crossing_number = 0,
+                                    const solver_options_t& options = {})
+        : sat_solver(graph, crossing_number, options),
+          ipasir_solver(nullptr),
+          variable_count(0),
+          bound_activation(0) {}
+
+    bool is_drawable() override;
+
+    ~incremental_sat_solver() override { if (ipasir_solver != nullptr) { ipasir_release(ipasir_solver); } }
+
+protected:
+    void add_literals(std::span<const int> literals) override {
+        for (int literal : literals) { ipasir_add(ipasir_solver, literal); }
+    }
+    bool is_true(int literal) const override { return ipasir_val(ipasir_solver, literal) == literal; }
+
+private:
+    void initialise_solver();
+};
+
+#endif //OKP_RECOGNITION_INCREMENTAL_SAT_SOLVER_H
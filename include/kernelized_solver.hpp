@@ -0,0 +1,47 @@
+#ifndef OKP_RECOGNITION_KERNELIZED_SOLVER_H
+#define OKP_RECOGNITION_KERNELIZED_SOLVER_H
+
+#include <iostream>
+#include "abstract_solver.h"
+#include "graph_kernel.h"
+
+/*
+ * Solves the kernel of the graph (see graph_kernel_t) with the sub solver
+ * and lifts its drawing back. The reductions keep the local crossing number,
+ * so the result is the same, only the models are built for fewer vertices.
+ */
+template <class sub_solver>
+class kernelized_solver : public abstract_solver {
+public:
+    explicit kernelized_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : abstract_solver(graph, crossing_number, options) {}
+
+    bool solve() override {
+        graph_kernel_t kernel(graph);
+        const graph_view_t& reduced = kernel.reduced();
+#ifndef PERF_TEST
+        std::cerr << "Kernel: " << reduced.num_vertices() << " of " << num_vertices(graph) << " vertices, "
+            << reduced.num_edges() << " of " << num_edges(graph) << " edges" << std::endl;
+#endif
+
+        std::vector<vertex_t> kernel_order;
+        // Up to three vertices are drawn without crossings in any order
+        if (reduced.num_vertices() <= 3) {
+            for (int v = 0; v < reduced.num_vertices(); ++v) { kernel_order.push_back(reduced.global_vertex(v)); }
+        } else {
+            graph_t kernel_graph = reduced.to_graph();
+            sub_solver kernel_solver(kernel_graph, crossing_number, options);
+            bool solved = kernel_solver.solve();
+            crossing_number = kernel_solver.crossing_number;
+            oracle_calls = kernel_solver.oracle_calls;
+            if (!solved) { return false; }
+            for (vertex_t v : kernel_solver.vertex_order) {
+                kernel_order.push_back(reduced.global_vertex(static_cast<int>(get(boost::vertex_index, kernel_graph, v))));
+            }
+        }
+        vertex_order = kernel.lift(kernel_order);
+        return true;
+    }
+};
+
+#endif //OKP_RECOGNITION_KERNELIZED_SOLVER_H
@@ -0,0 +1,30 @@
+#ifndef OKP_RECOGNITION_LOWER_BOUND_H
+#define OKP_RECOGNITION_LOWER_BOUND_H
+
+#include "graph.h"
+#include "graph_view.h"
+
+/*
+ * Lower bounds on the local crossing number of every outer drawing of a
+ * graph, computed without looking at any drawing. All of them also hold for
+ * subgraphs, so each one is applied to the densest parts of the graph:
+ *  - degeneracy: outer k-planar graphs are (floor(sqrt(4k + 1)) + 1)-degenerate
+ *    (Chaplick et al., Beyond outerplanarity);
+ *  - cliques: the only outer drawing of K_q has an edge with
+ *    floor((q - 2) / 2) * ceil((q - 2) / 2) crossings;
+ *  - density: an outer drawing with m edges on n vertices has X >= m - 2n + 3
+ *    crossings, and X >= m^3 / (27 n^2) if m >= 3n by the crossing lemma for
+ *    convex drawings, so one of its edges has at least 2X / m. This is
+ *    checked for every biconnected block and, within a block, for every
+ *    core of the degeneracy order.
+ */
+int degeneracy_lower_bound(const graph_t& graph);
+int clique_lower_bound(const graph_t& graph);
+int density_lower_bound(const graph_t& graph);
+
+// Largest of the bounds above
+int local_crossing_lower_bound(const graph_t& graph);
+// Same for a block, the view is not split into blocks again
+int local_crossing_lower_bound(const graph_view_t& block);
+
+#endif //OKP_RECOGNITION_LOWER_BOUND_H
@@ -5,14 +5,20 @@
 #include <boost/program_options.hpp>
 #include <string>
 #include "bicomponent_solver.hpp"
+#include "triconnected_solver.hpp"
+#include "kernelized_solver.hpp"
 #include "ilp_solver.h"
 #include "sat_solver.h"
+#include "incremental_sat_solver.h"
 #include "dp_solver.h"
+#include "heuristic_solver.h"
 
 enum solver_type {
     ILP_SOLVER,
     SAT_SOLVER,
+    INCREMENTAL_SAT_SOLVER,
     DP_SOLVER,
+    HEURISTIC_SOLVER,
 };
 
 inline std::istream& operator>>(std::istream& in, solver_type& solver_type) {
@@ -23,8 +29,12 @@ inline std::istream& operator>>(std::istream& in, solver_type& solver_type) {
         solver_type = ILP_SOLVER;
     } else if (token == "sat") {
         solver_type = SAT_SOLVER;
+    } else if (token == "isat") {
+        solver_type = INCREMENTAL_SAT_SOLVER;
     } else if (token == "dp") {
         solver_type = DP_SOLVER;
+    } else if (token == "heuristic") {
+        solver_type = HEURISTIC_SOLVER;
     } else {
         throw boost::program_options::validation_error(
             boost::program_options::validation_error::invalid_option,
@@ -33,5 +43,89 @@ inline std::istream& operator>>(std::istream& in, solver_type& solver_type) {
     return in;
 }
 
+inline std::istream& operator>>(std::istream& in, dp_arrangements_t& arrangements) {
+    std::string token;
+    in >> token;
+    boost::algorithm::to_lower(token);
+    if (token == "pruned") {
+        arrangements = PRUNED_ARRANGEMENTS;
+    } else if (token == "all") {
+        arrangements = ALL_ARRANGEMENTS;
+    } else {
+        throw boost::program_options::validation_error(
+            boost::program_options::validation_error::invalid_option_value,
+            "dp-arrangements", token);
+    }
+    return in;
+}
+
+inline std::istream& operator>>(std::istream& in, sat_cardinality_t& cardinality) {
+    std::string token;
+    in >> token;
+    boost::algorithm::to_lower(token);
+    if (token == "binomial") {
+        cardinality = BINOMIAL_CARDINALITY;
+    } else if (token == "sequential") {
+        cardinality = SEQUENTIAL_CARDINALITY;
+    } else if (token == "totalizer") {
+        cardinality = TOTALIZER_CARDINALITY;
+    } else if (token == "network") {
+        cardinality = NETWORK_CARDINALITY;
+    } else {
+        throw boost::program_options::validation_error(
+            boost::program_options::validation_error::invalid_option_value,
+            "sat-cardinality", token);
+    }
+    return in;
+}
+inline std::istream& operator>>(std::istream& in, ilp_transitivity_t& transitivity) {
+    std::string token;
+    in >> token;
+    boost::algorithm::to_lower(token);
+    if (token == "eager") {
+        transitivity = EAGER_TRANSITIVITY;
+    } else if (token == "lazy") {
+        transitivity = LAZY_TRANSITIVITY;
+    } else {
+        throw boost::program_options::validation_error(
+            boost::program_options::validation_error::invalid_option_value,
+            "ilp-transitivity", token);
+    }
+    return in;
+}
+
+inline std::istream& operator>>(std::istream& in, ilp_crossings_t& crossings) {
+    std::string token;
+    in >> token;
+    boost::algorithm::to_lower(token);
+    if (token == "eager") {
+        crossings = EAGER_CROSSINGS;
+    } else if (token == "lazy") {
+        crossings = LAZY_CROSSINGS;
+    } else {
+        throw boost::program_options::validation_error(
+            boost::program_options::validation_error::invalid_option_value,
+            "ilp-crossings", token);
+    }
+    return in;
+}
+
+inline std::istream& operator>>(std::istream& in, search_strategy_t& strategy) {
+    std::string token;
+    in >> token;
+    boost::algorithm::to_lower(token);
+    if (token == "linear") {
+        strategy = LINEAR_SEARCH;
+    } else if (token == "bounded") {
+        strategy = BOUNDED_SEARCH;
+    } else if (token == "galloping") {
+        strategy = GALLOPING_SEARCH;
+    } else {
+        throw boost::program_options::validation_error(
+            boost::program_options::validation_error::invalid_option_value,
+            "search", token);
+    }
+    return in;
+}
 
 #endif //OKP_RECOGNITION_H
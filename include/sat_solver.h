@@ -1,8 +1,12 @@
 #ifndef OKP_RECOGNITION_SAT_SOLVER_H
 #define OKP_RECOGNITION_SAT_SOLVER_H
 
+#include <array>
+#include <span>
 #include <vector>
 #include "abstract_solver.h"
+#include "cardinality_encoder.h"
+#include "crossable_pairs.h"
 
 extern "C" {
 #include <kissat.h>
@@ -12,33 +16,80 @@ class sat_solver : public abstract_solver {
     typedef boost::property_map<graph_t, boost::edge_index_t>::const_type edge_index_map_t;
     typedef boost::property_map<graph_t, boost::vertex_index_t>::const_type vertex_index_map_t;
 
+protected:
     const vertex_index_map_t vertex_index_map;
     const edge_index_map_t edge_index_map;
+
+private:
     kissat* kissat_solver;
 
 public:
-    explicit sat_solver(const graph_t& graph, int crossing_number = 0)
-        : abstract_solver(graph, crossing_number),
+    explicit sat_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : abstract_solver(graph, crossing_number, options),
           vertex_index_map(get(boost::vertex_index, graph)),
           edge_index_map(get(boost::edge_index, graph)),
-          kissat_solver(nullptr) {}
+          kissat_solver(nullptr),
+          crossable_pairs(graph) {}
 
     bool solve() override;
 
-    bool is_drawable();
+    virtual bool is_drawable();
 
     ~sat_solver() override { if (kissat_solver != nullptr) { kissat_release(kissat_solver); } }
 
-private:
-    void initialise_solver();
+protected:
+    // First variable, fixed to false by a unit clause
+    static constexpr int false_literal = 1;
+
+    // Backend of the encoding: adds the literals of whole clauses, each one closed by 0
+    virtual void add_literals(std::span<const int> literals) {
+        for (int literal : literals) { kissat_add(kissat_solver, literal); }
+    }
+    // Value of a literal in the model found by the last successful call. The
+    // solver returns the literal itself if it is true, also for negative ones.
+    virtual bool is_true(int literal) const { return kissat_value(kissat_solver, literal) == literal; }
+
+    // Clauses are collected in clause_buffer and passed to the backend in bulk
+    void add(int literal) {
+        clause_buffer.push_back(literal);
+        if (literal != 0) { return; }
+        ++clause_count;
+        if (clause_buffer.size() >= flush_size) { flush(); }
+    }
+    // Passes the buffered clauses to the backend, has to be called before solving
+    void flush() {
+        add_literals(clause_buffer);
+        clause_buffer.clear();
+    }
+    void print_statistics(int variable_count, size_t solve_time) const;
+
     void setup_order_variables(int& variable_count);
     void transitivity_constraints();
+    // Unit clauses of find_order_symmetries, if enabled
+    void symmetry_breaking_constraints();
     void setup_crossing_variables(int& variable_count);
-    void local_crossing_constraint();
-    void add_crossing_clauses(const edge_t& edge1, const edge_t& edge2, int crossing_var) const;
+    // Clauses bounding the crossings of every edge by crossing_number, encoded
+    // as chosen by options.sat_cardinality. With a nonzero activation literal
+    // they only apply while it is assumed.
+    void local_crossing_constraint(int& variable_count, int activation = 0);
+    // Clauses linking the crossing variable of the edges uv and st with ends
+    // (u, v, s, t) to the order, one emitter for each value of options.exact_crossings
+    template <bool exact>
+    void add_crossing_clauses(const std::array<int, 4>& ends, int crossing_var);
 
     std::vector<std::vector<int>> order_variables;
-    std::vector<std::vector<int>> crossing_variables;
+    // Pair p of crossable_pairs has the crossing variable first_crossing_variable + p
+    const crossable_pairs_t crossable_pairs;
+    int first_crossing_variable = 0;
+    size_t clause_count = 0;
+
+private:
+    static constexpr size_t flush_size = 1 << 16;
+
+    std::vector<int> clause_buffer;
+
+    // Returns the number of variables of the formula
+    int initialise_solver();
 };
 
 #endif //OKP_RECOGNITION_SAT_SOLVER_H
@@ -0,0 +1,70 @@
+#ifndef OKP_RECOGNITION_SOLVER_OPTIONS_H
+#define OKP_RECOGNITION_SOLVER_OPTIONS_H
+
+// How dp_solver enumerates the orders of the piercing edges of a cell
+enum dp_arrangements_t {
+    // Only orders compatible with both parts, cut off as soon as an edge has too many crossings
+    PRUNED_ARRANGEMENTS,
+    // All permutations, every one checked in full
+    ALL_ARRANGEMENTS,
+};
+
+// Encoding of the bound on the crossings of an edge in sat_solver
+enum sat_cardinality_t {
+    // One clause for every set of crossing_number + 1 other edges
+    BINOMIAL_CARDINALITY,
+    // Sequential counter of Sinz, O(m k) clauses per edge
+    SEQUENTIAL_CARDINALITY,
+    // Totalizer of Bailleux and Boufkhad cut off at k + 1, O(m k) clauses per edge
+    TOTALIZER_CARDINALITY,
+    // Cardinality network of Asin et al., O(m log^2 k) clauses per edge
+    NETWORK_CARDINALITY,
+};
+
+// How the solvers built on a decision procedure look for the crossing number
+enum search_strategy_t {
+    // k = 0, 1, 2, ... (or from the crossing number the solver was created with)
+    LINEAR_SEARCH,
+    // k = lower bound, lower bound + 1, ...
+    BOUNDED_SEARCH,
+    // Doubling steps from the lower bound, then bisection of the last step
+    GALLOPING_SEARCH,
+};
+
+// How ilp_solver enforces the transitivity of the order
+enum ilp_transitivity_t {
+    // All constraints are in the model from the start
+    EAGER_TRANSITIVITY,
+    // Constraints violated by a new incumbent are added by a callback
+    LAZY_TRANSITIVITY,
+};
+
+// How ilp_solver links the crossing variables to the order
+enum ilp_crossings_t {
+    // All constraints are in the model from the start
+    EAGER_CROSSINGS,
+    // Constraints violated by an incumbent or a node relaxation are added by a callback
+    LAZY_CROSSINGS,
+};
+
+// Settings shared by all solvers that do not depend on the input graph
+struct solver_options_t {
+    // Number of threads a single solver may use
+    int threads = 1;
+    dp_arrangements_t dp_arrangements = PRUNED_ARRANGEMENTS;
+    sat_cardinality_t sat_cardinality = SEQUENTIAL_CARDINALITY;
+    search_strategy_t search_strategy = BOUNDED_SEARCH;
+    ilp_transitivity_t ilp_transitivity = EAGER_TRANSITIVITY;
+    ilp_crossings_t ilp_crossings = EAGER_CROSSINGS;
+    // Clauses and constraints of sat_solver and ilp_solver also forcing the crossing variables to 0 if the edges
+    // do not cross, instead of only to 1 if they do
+    bool exact_crossings = false;
+    // Total number of crossings divided by m^2 added to the objective of ilp_solver
+    bool crossing_sum_objective = false;
+    // Simulated annealing swaps per vertex of heuristic_drawing, 0 keeps the constructive orders
+    int heuristic_moves = 200;
+    // Constraints of sat_solver and ilp_solver excluding rotated, reflected and twin-permuted orders
+    bool symmetry_breaking = true;
+};
+
+#endif //OKP_RECOGNITION_SOLVER_OPTIONS_H
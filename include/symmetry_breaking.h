@@ -0,0 +1,34 @@
+#ifndef OKP_RECOGNITION_SYMMETRY_BREAKING_H
+#define OKP_RECOGNITION_SYMMETRY_BREAKING_H
+
+#include <utility>
+#include <vector>
+#include "graph.h"
+
+/*
+ * Symmetries of the linear orders encoding a circular drawing in sat_solver
+ * and ilp_solver. All 2n rotations and reflections of an order are the same
+ * drawing, and twins (vertices with the same open or closed neighbourhood)
+ * can be exchanged by an automorphism of the graph. Every drawing can be
+ * turned into one with the first vertex at the start, the reflection pair in
+ * order, if any, and every twin class in increasing order, in this sequence:
+ * the reflection keeps the first vertex and the twin classes contain none of
+ * the three vertices.
+ */
+struct order_symmetries_t {
+    // Vertex index placed first
+    int first = -1;
+    // Vertex indices placed in this order by a reflection, -1 if there is no such pair
+    std::pair<int, int> reflection{-1, -1};
+    // Vertex indices of every class of twins, placed in increasing order
+    std::vector<std::vector<int>> twin_classes;
+
+    // All pairs (u, v) with u before v, the first vertex is before all others
+    std::vector<std::pair<int, int>> ordered_pairs(int num_vertices) const;
+    // Turns a linear order into the one of the same drawing fulfilling the constraints
+    void canonicalise(std::vector<vertex_t>& order, const graph_t& graph) const;
+};
+
+order_symmetries_t find_order_symmetries(const graph_t& graph);
+
+#endif //OKP_RECOGNITION_SYMMETRY_BREAKING_H
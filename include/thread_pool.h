@@ -0,0 +1,63 @@
+#ifndef OKP_RECOGNITION_THREAD_POOL_H
+#define OKP_RECOGNITION_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Fixed-size pool executing parallel loops with work stealing. Indices of a
+ * loop are split into contiguous blocks, one per worker; every worker takes
+ * tasks from the front of its own block and, once it runs dry, steals from
+ * the back of the blocks of the others. The calling thread acts as worker 0,
+ * so a pool of one thread runs everything inline.
+ */
+class thread_pool {
+public:
+    explicit thread_pool(int num_threads);
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool();
+
+    // Calls task(index, worker) for every index in [0, num_tasks) and
+    // returns once all of them are finished. If a task throws, the tasks not
+    // started yet are skipped and the first exception is rethrown here.
+    void parallel_for(size_t num_tasks, const std::function<void(size_t, int)>& task);
+
+    int size() const { return static_cast<int>(queues.size()); }
+
+private:
+    struct task_queue_t {
+        std::mutex mutex;
+        std::deque<size_t> tasks;
+    };
+
+    void worker_loop(int worker);
+    void run_tasks(int worker);
+    bool pop_task(int worker, size_t& index);
+    bool steal_task(int worker, size_t& index);
+
+    std::vector<std::unique_ptr<task_queue_t>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable wake_condition;
+    std::condition_variable done_condition;
+    const std::function<void(size_t, int)>* current_task = nullptr;
+    size_t generation = 0;
+    int active_workers = 0;
+    // First exception thrown by a task of the current loop
+    std::exception_ptr task_exception;
+    std::atomic<bool> task_failed = false;
+    bool stopping = false;
+};
+
+#endif //OKP_RECOGNITION_THREAD_POOL_H
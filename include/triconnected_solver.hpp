@@ -0,0 +1,175 @@
+#ifndef OKP_RECOGNITION_TRICONNECTED_SOLVER_H
+#define OKP_RECOGNITION_TRICONNECTED_SOLVER_H
+
+#include <algorithm>
+#include <iostream>
+#include <optional>
+#include <ranges>
+#include "abstract_solver.h"
+#include "graph_view.h"
+
+/*
+ * Splits the graph recursively at separation pairs {a, b} joined by an edge:
+ * one component C of G - {a, b} gives the part G[C + {a, b}], the rest of the
+ * graph the other part G - C. Both parts contain the edge ab, so they are
+ * subgraphs of G and their crossing numbers are lower bounds. If a and b are
+ * consecutive in the drawings of both parts, the drawings are glued into
+ * a, <C>, b, <rest> without new crossings, and the crossing number is the
+ * larger one of the parts. Otherwise the graph is solved as a whole, starting
+ * at the crossing numbers of the parts. Pairs without an edge are never
+ * split, as the parts would need a virtual edge that is not in G. The most
+ * balanced split is taken first.
+ */
+template <class sub_solver>
+class triconnected_solver : public abstract_solver {
+public:
+    explicit triconnected_solver(const graph_t& graph, int crossing_number = 0, const solver_options_t& options = {})
+        : abstract_solver(graph, crossing_number, options) {}
+
+    bool solve() override {
+        std::vector<vertex_t> all_vertices(vertices(graph).first, vertices(graph).second);
+        std::vector<std::pair<int, int>> all_edges;
+        for (edge_t edge : boost::make_iterator_range(edges(graph))) {
+            all_edges.emplace_back(static_cast<int>(get(boost::vertex_index, graph, source(edge, graph))),
+                                   static_cast<int>(get(boost::vertex_index, graph, target(edge, graph))));
+        }
+        part_solution_t solution = solve_part(graph_view_t(std::move(all_vertices), std::move(all_edges)));
+        crossing_number = solution.crossing_number;
+        vertex_order = std::move(solution.vertex_order);
+#ifndef PERF_TEST
+        std::cerr << "Separation pairs merged: " << merged_splits << ", solved as a whole: " << failed_splits
+            << std::endl;
+#endif
+        return solution.solved;
+    }
+
+private:
+    struct part_solution_t {
+        bool solved = false;
+        int crossing_number = 0;
+        // Vertices of the whole graph
+        std::vector<vertex_t> vertex_order;
+    };
+
+    struct split_t {
+        int a;
+        int b;
+        // Local vertices of the component C
+        std::vector<bool> in_component;
+    };
+
+    part_solution_t solve_part(const graph_view_t& part) {
+        std::optional<split_t> split = find_split(part);
+        if (!split) { return solve_directly(part, crossing_number); }
+
+        std::vector<bool> first_side = split->in_component;
+        std::vector<bool> second_side(part.num_vertices());
+        for (int v = 0; v < part.num_vertices(); ++v) { second_side[v] = !first_side[v]; }
+        first_side[split->a] = first_side[split->b] = true;
+        part_solution_t first = solve_part(induced_subgraph(part, first_side));
+        part_solution_t second = solve_part(induced_subgraph(part, second_side));
+
+        vertex_t a = part.global_vertex(split->a);
+        vertex_t b = part.global_vertex(split->b);
+        if (first.solved && second.solved && arrange(first.vertex_order, a, b) && arrange(second.vertex_order, b, a)) {
+            ++merged_splits;
+            first.vertex_order.pop_back();
+            first.vertex_order.insert(first.vertex_order.end(), second.vertex_order.begin(),
+                                      second.vertex_order.end() - 1);
+            first.crossing_number = std::max(first.crossing_number, second.crossing_number);
+            return first;
+        }
+        ++failed_splits;
+        // The parts are subgraphs, their crossing numbers bound the one of the whole part
+        int lower_bound = crossing_number;
+        if (first.solved) { lower_bound = std::max(lower_bound, first.crossing_number); }
+        if (second.solved) { lower_bound = std::max(lower_bound, second.crossing_number); }
+        return solve_directly(part, lower_bound);
+    }
+
+    part_solution_t solve_directly(const graph_view_t& part, int lower_bound) {
+        part_solution_t solution;
+        graph_t part_graph = part.to_graph();
+        sub_solver part_solver(part_graph, lower_bound, options);
+        solution.solved = part_solver.solve();
+        solution.crossing_number = part_solver.crossing_number;
+        oracle_calls += part_solver.oracle_calls;
+        for (vertex_t v : part_solver.vertex_order) {
+            solution.vertex_order.push_back(part.global_vertex(static_cast<int>(get(boost::vertex_index, part_graph, v))));
+        }
+        return solution;
+    }
+
+    // Rotates and mirrors a circular order into first, ..., last, false if the two are not consecutive
+    static bool arrange(std::vector<vertex_t>& order, vertex_t first, vertex_t last) {
+        auto first_position = std::ranges::find(order, first);
+        std::ranges::rotate(order, first_position);
+        if (order.back() == last) { return true; }
+        if (order.size() < 2 || order[1] != last) { return false; }
+        std::reverse(order.begin() + 1, order.end());
+        return true;
+    }
+
+    // Most balanced split at an edge ab with G - {a, b} disconnected
+    static std::optional<split_t> find_split(const graph_view_t& part) {
+        int num_vertices = part.num_vertices();
+        std::optional<split_t> best;
+        int best_size = 0;
+        std::vector<int> component(num_vertices);
+        std::vector<int> stack;
+        for (auto [a, b] : part.edge_ends()) {
+            if (a == b) { continue; }
+            // Components of G - {a, b}
+            std::ranges::fill(component, -1);
+            component[a] = component[b] = num_vertices;
+            std::vector<int> sizes;
+            for (int root = 0; root < num_vertices; ++root) {
+                if (component[root] >= 0) { continue; }
+                int id = static_cast<int>(sizes.size());
+                sizes.push_back(0);
+                component[root] = id;
+                stack.push_back(root);
+                while (!stack.empty()) {
+                    int v = stack.back();
+                    stack.pop_back();
+                    ++sizes[id];
+                    for (int u : part.neighbours(v)) {
+                        if (component[u] < 0) {
+                            component[u] = id;
+                            stack.push_back(u);
+                        }
+                    }
+                }
+            }
+            if (sizes.size() < 2) { continue; }
+            for (int id = 0; id < static_cast<int>(sizes.size()); ++id) {
+                int size = std::min(sizes[id], num_vertices - 2 - sizes[id]);
+                if (size <= best_size) { continue; }
+                best_size = size;
+                best = split_t{a, b, std::vector<bool>(num_vertices)};
+                for (int v = 0; v < num_vertices; ++v) { best->in_component[v] = component[v] == id; }
+            }
+        }
+        return best;
+    }
+
+    static graph_view_t induced_subgraph(const graph_view_t& part, const std::vector<bool>& keep) {
+        std::vector<int> local_index(part.num_vertices(), -1);
+        std::vector<vertex_t> global_vertices;
+        for (int v = 0; v < part.num_vertices(); ++v) {
+            if (!keep[v]) { continue; }
+            local_index[v] = static_cast<int>(global_vertices.size());
+            global_vertices.push_back(part.global_vertex(v));
+        }
+        std::vector<std::pair<int, int>> part_edges;
+        for (auto [u, v] : part.edge_ends()) {
+            if (keep[u] && keep[v]) { part_edges.emplace_back(local_index[u], local_index[v]); }
+        }
+        return {std::move(global_vertices), std::move(part_edges)};
+    }
+
+    int merged_splits = 0;
+    int failed_splits = 0;
+};
+
+#endif //OKP_RECOGNITION_TRICONNECTED_SOLVER_H
@@ -0,0 +1,106 @@
+#ifndef OKP_RECOGNITION_VERTEX_SET_H
+#define OKP_RECOGNITION_VERTEX_SET_H
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstdint>
+
+/*
+ * Fixed-size set of vertex indices for graphs that do not fit into a single
+ * machine word. Supports the same bitwise operators as an unsigned integer, so
+ * dp_solver can use it interchangeably with uint64_t and unsigned __int128.
+ */
+template <size_t num_words>
+struct wide_vertex_set {
+    std::array<uint64_t, num_words> words{};
+
+    wide_vertex_set& operator&=(const wide_vertex_set& other) {
+        for (size_t i = 0; i < num_words; ++i) { words[i] &= other.words[i]; }
+        return *this;
+    }
+
+    wide_vertex_set& operator|=(const wide_vertex_set& other) {
+        for (size_t i = 0; i < num_words; ++i) { words[i] |= other.words[i]; }
+        return *this;
+    }
+
+    wide_vertex_set& operator^=(const wide_vertex_set& other) {
+        for (size_t i = 0; i < num_words; ++i) { words[i] ^= other.words[i]; }
+        return *this;
+    }
+
+    friend wide_vertex_set operator&(wide_vertex_set lhs, const wide_vertex_set& rhs) { return lhs &= rhs; }
+    friend wide_vertex_set operator|(wide_vertex_set lhs, const wide_vertex_set& rhs) { return lhs |= rhs; }
+    friend wide_vertex_set operator^(wide_vertex_set lhs, const wide_vertex_set& rhs) { return lhs ^= rhs; }
+
+    bool operator==(const wide_vertex_set&) const = default;
+
+    // Compares the sets as numbers, the highest word being the most significant
+    std::strong_ordering operator<=>(const wide_vertex_set& other) const {
+        for (size_t i = num_words; i-- > 0;) {
+            if (words[i] != other.words[i]) { return words[i] <=> other.words[i]; }
+        }
+        return std::strong_ordering::equal;
+    }
+};
+
+// Operations dp_solver needs on a vertex set type, for unsigned integer types
+template <class vertex_set_t>
+struct vertex_set_traits {
+    static constexpr int capacity = 8 * sizeof(vertex_set_t);
+
+    static vertex_set_t singleton(int v) { return static_cast<vertex_set_t>(1) << v; }
+
+    static bool contains(const vertex_set_t& set, int v) { return (set >> v & 1) != 0; }
+
+    static int size(const vertex_set_t& set) {
+        int count = 0;
+        for (int shift = 0; shift < capacity; shift += 64) {
+            count += std::popcount(static_cast<uint64_t>(set >> shift));
+        }
+        return count;
+    }
+
+    struct hash {
+        size_t operator()(const vertex_set_t& set) const {
+            uint64_t hash = 0;
+            for (int shift = 0; shift < capacity; shift += 64) {
+                hash = (hash ^ static_cast<uint64_t>(set >> shift)) * 0x9E3779B97F4A7C15ULL;
+            }
+            return hash ^ hash >> 32;
+        }
+    };
+};
+
+template <size_t num_words>
+struct vertex_set_traits<wide_vertex_set<num_words>> {
+    typedef wide_vertex_set<num_words> vertex_set_t;
+    static constexpr int capacity = 64 * num_words;
+
+    static vertex_set_t singleton(int v) {
+        vertex_set_t set;
+        set.words[v / 64] = uint64_t{1} << v % 64;
+        return set;
+    }
+
+    static bool contains(const vertex_set_t& set, int v) { return (set.words[v / 64] >> v % 64 & 1) != 0; }
+
+    static int size(const vertex_set_t& set) {
+        int count = 0;
+        for (uint64_t word : set.words) { count += std::popcount(word); }
+        return count;
+    }
+
+    struct hash {
+        size_t operator()(const vertex_set_t& set) const {
+            uint64_t hash = 0;
+            for (uint64_t word : set.words) {
+                hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+            }
+            return hash ^ hash >> 32;
+        }
+    };
+};
+
+#endif //OKP_RECOGNITION_VERTEX_SET_H
@@ -0,0 +1,64 @@
+#! /usr/bin/env python3
+import argparse
+import re
+import subprocess
+import sys
+import tempfile
+
+
+def get_arguments():
+    parser = argparse.ArgumentParser(
+        description="compare the running times of the DP for the different --dp-arrangements strategies")
+    parser.add_argument("graphs_file", help="file containing graphs in Graphviz format")
+    parser.add_argument("-b", "--bin-executable", help="path to the executable (default: bin/okp-recognition)",
+                        dest="exec", default="bin/okp-recognition")
+    parser.add_argument("-a", "--arrangements",
+                        help="strategies to compare, separated by ','; possible values: all, pruned (default: all,pruned)",
+                        dest="arrangements", default="all,pruned")
+    parser.add_argument("-s", "--slowest", help="number of slowest graphs to list (default: 10)",
+                        dest="slowest", type=int, default=10)
+    return parser.parse_args()
+
+
+def run_batch(executable: str, batch_file: str, arrangement: str):
+    process = subprocess.run([executable, "-f", batch_file, "-m", "dp", "--dp-arrangements", arrangement],
+                             capture_output=True, text=True)
+    if process.returncode != 0:
+        print(f"{arrangement} failed with return code {process.returncode}:\n{process.stderr}", file=sys.stderr)
+        sys.exit(1)
+    results = {}
+    for line in process.stdout.splitlines():
+        index, solved, cr, time = map(int, line.split(" "))
+        results[index] = (solved, cr, time)
+    return results
+
+
+def main():
+    args = get_arguments()
+    arrangements = args.arrangements.split(",")
+    with open(args.graphs_file, "r") as in_file:
+        graphs = re.findall(r'graph\s+\w\s+\{.*?\}', in_file.read())
+    with tempfile.NamedTemporaryFile("w", suffix=".txt") as batch_file:
+        batch_file.write("".join(graph.replace("\n", " ") + "\n" for graph in graphs))
+        batch_file.flush()
+        results = {arrangement: run_batch(args.exec, batch_file.name, arrangement) for arrangement in arrangements}
+
+    reference = results[arrangements[0]]
+    for arrangement in arrangements[1:]:
+        for index, (solved, cr, _) in reference.items():
+            if results[arrangement][index][:2] != (solved, cr):
+                print(f"graph {index}: {arrangements[0]} gives {cr}, {arrangement} gives "
+                      f"{results[arrangement][index][1]}", file=sys.stderr)
+
+    for arrangement in arrangements:
+        total = sum(time for _, _, time in results[arrangement].values()) / 1.0e9
+        print(f"{arrangement}: {total:.3f} s for {len(graphs)} graphs")
+    slowest = sorted(reference, key=lambda index: reference[index][2], reverse=True)[:args.slowest]
+    print("slowest graphs (ms): index " + " ".join(arrangements))
+    for index in slowest:
+        times = " ".join(f"{results[arrangement][index][2] / 1.0e6:.1f}" for arrangement in arrangements)
+        print(f"{index} {times}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+#! /usr/bin/env python3
+import argparse
+import re
+import subprocess
+import sys
+
+STATISTICS = re.compile(r'^ILP model: (\d+) variables, (\d+) constraints, built in ([\d.e+-]+) s, '
+                        r'solved in ([\d.e+-]+) s, (\d+) lazy constraints$', re.M)
+CROSSING_NUMBER = re.compile(r'^Crossing number: (\d+)$', re.M)
+MODES = {
+    "eager": [],
+    "lazy-crossings": ["--ilp-crossings", "lazy"],
+    "lazy-transitivity": ["--ilp-transitivity", "lazy"],
+    "lazy": ["--ilp-crossings", "lazy", "--ilp-transitivity", "lazy"],
+}
+
+
+def get_arguments():
+    parser = argparse.ArgumentParser(
+        description="compare the model sizes, build and solve times of the eager ILP model with the lazy "
+                    "constraint generation; requires an executable built without PERF_TEST")
+    parser.add_argument("graphs_file", help="file containing graphs in Graphviz format")
+    parser.add_argument("-b", "--bin-executable", help="path to the executable (default: bin/okp-recognition)",
+                        dest="exec", default="bin/okp-recognition")
+    parser.add_argument("-M", "--modes",
+                        help="modes to compare, separated by ','; possible values: eager, lazy-crossings, "
+                             "lazy-transitivity, lazy (default: eager,lazy-crossings,lazy)",
+                        dest="modes", default="eager,lazy-crossings,lazy")
+    parser.add_argument("-t", "--timeout", help="timeout for each graph in seconds (default: 600)",
+                        dest="timeout", type=int, default=600)
+    return parser.parse_args()
+
+
+def run_graph(executable: str, graph: str, mode: str, timeout: int):
+    """Returns the crossing number and the variables, constraints, build time, solve time and lazy constraints
+    summed over all solved models"""
+    try:
+        process = subprocess.run([executable, graph, "-m", "ilp", "-b"] + MODES[mode],
+                                 capture_output=True, text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return None
+    # One line per solved model, e.g. per block with -b
+    models = STATISTICS.findall(process.stderr)
+    cr = CROSSING_NUMBER.search(process.stdout)
+    if process.returncode != 0 or not models or cr is None:
+        print(f"{mode} failed for {graph}:\n{process.stderr}", file=sys.stderr)
+        return None
+    variables, constraints, build, solve, lazy = (sum(map(convert, column))
+                                                  for convert, column in zip((int, int, float, float, int),
+                                                                             zip(*models)))
+    return int(cr.group(1)), variables, constraints, build, solve, lazy
+
+
+def main():
+    args = get_arguments()
+    modes = args.modes.split(",")
+    with open(args.graphs_file, "r") as in_file:
+        graphs = re.findall(r'graph\s+\w\s+\{.*?\}', in_file.read())
+
+    print("graph " + " ".join(f"{mode}:cr/variables/constraints/build/solve/lazy" for mode in modes))
+    totals = {mode: [0, 0, 0.0, 0.0, 0, 0] for mode in modes}
+    for index, graph in enumerate(graphs):
+        results = {mode: run_graph(args.exec, graph, mode, args.timeout) for mode in modes}
+        crossing_numbers = {result[0] for result in results.values() if result is not None}
+        if len(crossing_numbers) > 1:
+            print(f"graph {index}: the modes disagree on the crossing number", file=sys.stderr)
+        columns = []
+        for mode, result in results.items():
+            if result is None:
+                columns.append("timeout")
+                continue
+            cr, variables, constraints, build, solve, lazy = result
+            columns.append(f"{cr}/{variables}/{constraints}/{build:.3f}/{solve:.3f}/{lazy}")
+            for position, value in enumerate((variables, constraints, build, solve, lazy, 1)):
+                totals[mode][position] += value
+        print(f"{index} " + " ".join(columns))
+
+    for mode, (variables, constraints, build, solve, lazy, solved) in totals.items():
+        print(f"{mode}: {solved}/{len(graphs)} graphs solved, {variables} variables, {constraints} constraints "
+              f"(+{lazy} lazy), {build:.3f} s building, {solve:.3f} s solving")
+
+
+if __name__ == "__main__":
+    main()
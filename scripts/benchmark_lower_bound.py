@@ -0,0 +1,68 @@
+#! /usr/bin/env python3
+import argparse
+import re
+import subprocess
+import sys
+
+CROSSING_NUMBER = re.compile(r'^Crossing number: (\d+)$', re.M)
+ORACLE_CALLS = re.compile(r'^Oracle calls: (\d+)$', re.M)
+TIME = re.compile(r'^Time elapsed: ([\d.e+-]+) s$', re.M)
+
+
+def get_arguments():
+    parser = argparse.ArgumentParser(
+        description="count the calls of the decision procedure saved by starting the search at the lower bound "
+                    "(--search bounded) instead of 0 (--search linear); requires an executable built without "
+                    "PERF_TEST")
+    parser.add_argument("graphs_file", help="file containing graphs in Graphviz format")
+    parser.add_argument("-b", "--bin-executable", help="path to the executable (default: bin/okp-recognition)",
+                        dest="exec", default="bin/okp-recognition")
+    parser.add_argument("-m", "--method", help="method to use, one of sat, isat, dp (default: dp)",
+                        dest="method", default="dp")
+    parser.add_argument("-t", "--timeout", help="timeout for each graph in seconds (default: 600)",
+                        dest="timeout", type=int, default=600)
+    return parser.parse_args()
+
+
+def run_graph(executable: str, graph: str, method: str, search: str, timeout: int):
+    """Returns the crossing number, the oracle calls and the time, None if the graph was not solved"""
+    try:
+        process = subprocess.run([executable, graph, "-m", method, "--search", search],
+                                 capture_output=True, text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return None
+    cr = CROSSING_NUMBER.search(process.stdout)
+    if process.returncode != 0 or cr is None:
+        return None
+    calls = ORACLE_CALLS.search(process.stdout)
+    return int(cr.group(1)), int(calls.group(1)) if calls else 0, float(TIME.search(process.stdout).group(1))
+
+
+def main():
+    args = get_arguments()
+    with open(args.graphs_file, "r") as in_file:
+        graphs = re.findall(r'graph\s+\w\s+\{.*?\}', in_file.read())
+
+    print("graph cr linear:calls/time bounded:calls/time")
+    saved_calls, linear_calls, linear_time, bounded_time, solved = 0, 0, 0.0, 0.0, 0
+    for index, graph in enumerate(graphs):
+        linear = run_graph(args.exec, graph, args.method, "linear", args.timeout)
+        bounded = run_graph(args.exec, graph, args.method, "bounded", args.timeout)
+        if linear is None or bounded is None:
+            print(f"{index} unsolved")
+            continue
+        if linear[0] != bounded[0]:
+            print(f"graph {index}: linear gives {linear[0]}, bounded gives {bounded[0]}", file=sys.stderr)
+        print(f"{index} {bounded[0]} {linear[1]}/{linear[2]:.4f} {bounded[1]}/{bounded[2]:.4f}")
+        saved_calls += linear[1] - bounded[1]
+        linear_calls += linear[1]
+        linear_time += linear[2]
+        bounded_time += bounded[2]
+        solved += 1
+
+    print(f"{solved}/{len(graphs)} graphs solved by both, the lower bound saved {saved_calls} of {linear_calls} "
+          f"oracle calls, {linear_time:.3f} s -> {bounded_time:.3f} s")
+
+
+if __name__ == "__main__":
+    main()
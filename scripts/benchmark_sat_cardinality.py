@@ -0,0 +1,77 @@
+#! /usr/bin/env python3
+import argparse
+import re
+import subprocess
+import sys
+
+STATISTICS = re.compile(r'^SAT crossing number (\d+): (\d+) variables, (\d+) clauses, solved in ([\d.e+-]+) s$')
+
+
+def get_arguments():
+    parser = argparse.ArgumentParser(
+        description="compare the formula sizes and solve times of the --sat-cardinality encodings; "
+                    "requires an executable built without PERF_TEST")
+    parser.add_argument("graphs_file", help="file containing graphs in Graphviz format")
+    parser.add_argument("-b", "--bin-executable", help="path to the executable (default: bin/okp-recognition)",
+                        dest="exec", default="bin/okp-recognition")
+    parser.add_argument("-m", "--method", help="method to use, one of sat, isat (default: sat)",
+                        dest="method", default="sat")
+    parser.add_argument("-e", "--encodings",
+                        help="encodings to compare, separated by ','; possible values: binomial, sequential, "
+                             "totalizer, network (default: binomial,sequential,totalizer,network)",
+                        dest="encodings", default="binomial,sequential,totalizer,network")
+    parser.add_argument("-t", "--timeout", help="timeout for each graph in seconds (default: 600)",
+                        dest="timeout", type=int, default=600)
+    return parser.parse_args()
+
+
+def run_graph(executable: str, graph: str, method: str, encoding: str, timeout: int):
+    """Returns the crossing number, the statistics of the last SAT call and the total SAT time"""
+    try:
+        process = subprocess.run([executable, graph, "-m", method, "-b", "--sat-cardinality", encoding],
+                                 capture_output=True, text=True, timeout=timeout)
+    except subprocess.TimeoutExpired:
+        return None
+    calls = [tuple(map(float, match.groups())) for line in process.stderr.splitlines()
+             if (match := STATISTICS.match(line))]
+    if process.returncode != 0 or not calls:
+        print(f"{encoding} failed for {graph}:\n{process.stderr}", file=sys.stderr)
+        return None
+    _, variables, clauses, _ = calls[-1]
+    return int(calls[-1][0]), int(variables), int(clauses), sum(call[3] for call in calls)
+
+
+def main():
+    args = get_arguments()
+    encodings = args.encodings.split(",")
+    with open(args.graphs_file, "r") as in_file:
+        graphs = re.findall(r'graph\s+\w\s+\{.*?\}', in_file.read())
+
+    print("graph " + " ".join(f"{encoding}:cr/variables/clauses/time" for encoding in encodings))
+    totals = {encoding: [0, 0, 0.0, 0] for encoding in encodings}
+    for index, graph in enumerate(graphs):
+        results = {encoding: run_graph(args.exec, graph, args.method, encoding, args.timeout)
+                   for encoding in encodings}
+        crossing_numbers = {result[0] for result in results.values() if result is not None}
+        if len(crossing_numbers) > 1:
+            print(f"graph {index}: the encodings disagree on the crossing number", file=sys.stderr)
+        columns = []
+        for encoding, result in results.items():
+            if result is None:
+                columns.append("timeout")
+                continue
+            cr, variables, clauses, time = result
+            columns.append(f"{cr}/{variables}/{clauses}/{time:.3f}")
+            totals[encoding][0] += variables
+            totals[encoding][1] += clauses
+            totals[encoding][2] += time
+            totals[encoding][3] += 1
+        print(f"{index} " + " ".join(columns))
+
+    for encoding, (variables, clauses, time, solved) in totals.items():
+        print(f"{encoding}: {solved}/{len(graphs)} graphs solved, {variables} variables and {clauses} clauses "
+              f"in the last calls, {time:.3f} s solving")
+
+
+if __name__ == "__main__":
+    main()
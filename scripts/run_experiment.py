@@ -16,12 +16,12 @@ def get_arguments():
     parser.add_argument("-p", "--subprocesses", help="number of subprocesses to use at the same time (default: 1)",
                         dest="subprocesses", type=int, default=1)
     parser.add_argument("-b", "--bin-executables",
-                        help="path to an executables separated by ',' (default: bin/okp-recognition-obj)",
-                        dest="execs", default="bin/okp-recognition-obj")
+                        help="executables with their options separated by ',' (default: bin/okp-recognition --crossing-sum-objective)",
+                        dest="execs", default="bin/okp-recognition --crossing-sum-objective")
     parser.add_argument("-o", "--output", help="output file for all evaluations (default: data/results.csv)",
                         dest="out", default="data/results.csv")
     parser.add_argument("-m", "--methods",
-                        help="methods to use, separated by ','; possible values: ilp, sat, dp (default: ilp,sat,dp)",
+                        help="methods to use, separated by ','; possible values: ilp, sat, isat, dp, heuristic (default: ilp,sat,dp)",
                         dest="methods", default="ilp,sat,dp")
     parser.add_argument("-t", "--timeout", help="timeout for each subprocess in seconds (default: 600)",
                         dest="timeout", type=int, default=600)
@@ -27,7 +27,9 @@ def visualise_biconnected(input_file, output_file, methods):
     results = results[(4 <= results['vertices']) & (results['cr'] <= 7)]
     results = results.rename({"executable": "Decomposition"}, axis=1)
     results = results.replace({"Decomposition": {"bin/okp-recognition-obj --no_bct": "No",
-                                                 "bin/okp-recognition-obj": "Yes"}})
+                                                 "bin/okp-recognition-obj": "Yes",
+                                                 "bin/okp-recognition --crossing-sum-objective --no-bct": "No",
+                                                 "bin/okp-recognition --crossing-sum-objective": "Yes"}})
     for method in methods:
         data = results[results['method'] == method]
         fig, ax = plt.subplots(1, 2, figsize=(21, 7.6))
@@ -91,7 +93,10 @@ def visualise_ilp_optimisations(input_file, output_file):
     data = data.replace({"Configuration": {"bin/okp-recognition": "No optimisations",
                                            "bin/okp-recognition-obj": "Objective optimisation",
                                            "bin/okp-recognition-exact": "Exact crossing variables",
-                                           "bin/okp-recognition-exact-obj": "Both"}})
+                                           "bin/okp-recognition-exact-obj": "Both",
+                                           "bin/okp-recognition --crossing-sum-objective": "Objective optimisation",
+                                           "bin/okp-recognition --exact-crossings": "Exact crossing variables",
+                                           "bin/okp-recognition --exact-crossings --crossing-sum-objective": "Both"}})
     fig, ax = plt.subplots(1, 1, figsize=(21, 7.6))
     plt.subplots_adjust(left=0.07, right=0.99, top=0.97, bottom=0.13)
     colors = sns.color_palette(PALETTE)[5:]
@@ -109,7 +114,8 @@ def visualise_sat_optimisations(input_file, output_file):
     data = read_input(input_file)
     data = data.rename({"executable": "Configuration"}, axis=1)
     data = data.replace({"Configuration": {"bin/okp-recognition": "No optimisations",
-                                           "bin/okp-recognition-exact": "Exact crossing variables"}})
+                                           "bin/okp-recognition-exact": "Exact crossing variables",
+                                           "bin/okp-recognition --exact-crossings": "Exact crossing variables"}})
     fig, ax = plt.subplots(1, 1, figsize=(10.5, 7.6))
     plt.subplots_adjust(left=0.13, right=0.99, top=0.97, bottom=0.13)
     sns.boxplot(x="cr", y="time", hue="Configuration", data=data, showfliers=False,
@@ -10,14 +10,63 @@ namespace fs = std::filesystem;
 command_line_options_t::command_line_options_t() {
     opt_conf.add_options()
         ("help,h", "Show help message")
-        ("input-graph,i", po::value<std::string>(&input_graph)->required(),
-         "Input graph in Graphviz format. Required.")
+        ("input-graph,i", po::value<std::string>(&input_graph)->default_value(""),
+         "Input graph in Graphviz format. Required unless --batch is given.")
+        ("batch,f", po::value<std::string>(&batch_file)->default_value(""),
+         "Path to a file with graphs to solve one after another, \"-\" for stdin. The file contains either "
+         "concatenated graphs in Graphviz format or one graph6 string per line. Prints one line per graph: "
+         "<index> <solved> <crossing number> <time in ns>")
+        ("threads,j", po::value<int>(&threads)->default_value(1),
+         "Number of threads. With --batch the graphs are solved in parallel, otherwise the solver itself uses "
+         "the threads (DP and ILP). Default: 1")
         ("output-file,o", po::value<std::string>(&output_file)->default_value(""),
          "Path to output file used to save graph drawing in Graphviz format. Default: \"\" (output is ignored)")
         ("method,m", po::value<solver_type>(&method)->default_value(ILP_SOLVER),
-         "Method to use for calculating the drawing of the input graph. One of the ILP, SAT, DP. Default: ILP")
+         "Method to use for calculating the drawing of the input graph. One of the ILP, SAT, ISAT (incremental SAT), DP, HEURISTIC (no optimality guarantee). Default: ILP")
+        ("dp-arrangements", po::value<dp_arrangements_t>(&dp_arrangements)->default_value(PRUNED_ARRANGEMENTS, "pruned"),
+         "Orders of the piercing edges the DP tries for every cell. One of pruned (only orders compatible with both "
+         "parts, cut off as soon as an edge exceeds the crossing number) or all (every permutation). Default: pruned")
+        ("sat-cardinality", po::value<sat_cardinality_t>(&sat_cardinality)->default_value(SEQUENTIAL_CARDINALITY,
+                                                                                           "sequential"),
+         "Encoding of the local crossing bound in SAT and ISAT. One of binomial (a clause for every set of k + 1 "
+         "edges), sequential (sequential counter), totalizer or network (cardinality network). Default: sequential")
+        ("search", po::value<search_strategy_t>(&search_strategy)->default_value(BOUNDED_SEARCH, "bounded"),
+         "How SAT, ISAT and DP search for the crossing number. One of linear (k = 0, 1, ...), bounded (k = lower "
+         "bound, lower bound + 1, ...) or galloping (doubling steps from the lower bound, then bisection). All of "
+         "them stop at the crossing number of the heuristic drawing. Default: bounded")
+        ("ilp-transitivity", po::value<ilp_transitivity_t>(&ilp_transitivity)->default_value(EAGER_TRANSITIVITY,
+                                                                                              "eager"),
+         "How ILP keeps the order transitive. One of eager (one constraint per orientation of every triple of "
+         "vertices in the model) or lazy (only the constraints violated by a new incumbent, added by a callback). "
+         "Default: eager")
+        ("ilp-crossings", po::value<ilp_crossings_t>(&ilp_crossings)->default_value(EAGER_CROSSINGS, "eager"),
+         "How ILP links the crossing variables to the order. One of eager (8 constraints per pair of edges, 24 "
+         "with --exact-crossings, in the model) or lazy (only the constraints violated by an incumbent or a node "
+         "relaxation, added by a callback). Default: eager")
+        ("exact-crossings", po::bool_switch(&exact_crossings)->default_value(false),
+         "Include this to add 16 clauses or constraints per pair of edges to SAT, ISAT and ILP that force its "
+         "crossing variable to 0 if the edges do not cross")
+        ("crossing-sum-objective", po::bool_switch(&crossing_sum_objective)->default_value(false),
+         "Include this to add the total number of crossings, divided by the squared number of edges, to the "
+         "objective of ILP")
+        ("heuristic-moves", po::value<int>(&heuristic_moves)->default_value(200),
+         "Simulated annealing swaps per vertex of the heuristic drawing, which is the result of HEURISTIC, the "
+         "MIP start of ILP and the upper bound of SAT, ISAT and DP. 0 keeps the best of the constructive orders. "
+         "Default: 200")
+        ("kernelize", po::bool_switch(&kernelize)->default_value(false),
+         "Include this to reduce the graph before solving it: pendant vertices are removed and chains of degree-2 "
+         "vertices longer than the rest of the graph are shortened. Prints the size of the reduced graph unless "
+         "compiled with PERF_TEST")
         ("no-bct,b", po::bool_switch(&no_bct_decomposition)->default_value(false),
-         "Include this to disable biconnected decomposition before passing it to the solver");
+         "Include this to disable biconnected decomposition before passing it to the solver")
+        ("no-symmetry-breaking", po::bool_switch(&no_symmetry_breaking)->default_value(false),
+         "Include this to disable the symmetry breaking constraints of ILP, SAT and ISAT, which fix the first "
+         "vertex, orient the order by a pair of vertices and put twins (vertices with equal neighbourhoods) in "
+         "increasing order")
+        ("split-pairs", po::bool_switch(&split_pairs)->default_value(false),
+         "Include this to split the blocks further at separation pairs joined by an edge. The parts are solved "
+         "separately and their drawings glued where this keeps the crossing number, otherwise the block is solved "
+         "as a whole");
     popt_conf.add("input-graph", 1);
 }
 
@@ -35,4 +84,7 @@ void command_line_options_t::parse(int ac, char** av) {
         exit(EXIT_SUCCESS);
     }
     notify(var_map);
+    if (input_graph.empty() && batch_file.empty()) {
+        throw po::required_option("input-graph");
+    }
 }
@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <bit>
+#include <string>
+#include "cardinality_encoder.h"
+
+void cardinality_encoder::at_most(sat_cardinality_t encoding, std::span<const int> literals, int bound,
+                                  int activation, int& variable_count) {
+    this->activation = activation;
+    this->variable_count = &variable_count;
+    if (static_cast<int>(literals.size()) <= bound) { return; }
+    if (bound == 0) {
+        for (int literal : literals) { add_clause({-literal}); }
+        return;
+    }
+
+    switch (encoding) {
+    case BINOMIAL_CARDINALITY:
+        binomial(literals, bound);
+        break;
+    case SEQUENTIAL_CARDINALITY:
+        sequential_counter(literals, bound);
+        break;
+    case TOTALIZER_CARDINALITY:
+        add_clause({-totalizer(literals, bound + 1)[bound]});
+        break;
+    case NETWORK_CARDINALITY: {
+        int limit = static_cast<int>(std::bit_ceil(static_cast<unsigned>(bound + 1)));
+        std::vector<int> inputs(literals.begin(), literals.end());
+        inputs.resize((inputs.size() + limit - 1) / limit * limit, false_literal);
+        add_clause({-cardinality_network(inputs, limit)[bound]});
+        break;
+    }
+    }
+}
+
+void cardinality_encoder::add_clause(std::initializer_list<int> literals) {
+    for (int literal : literals) { sink(literal); }
+    if (activation != 0) { sink(-activation); }
+    sink(0);
+}
+
+void cardinality_encoder::binomial(std::span<const int> literals, int bound) {
+    std::string chosen(bound + 1, 1);
+    chosen.resize(literals.size(), 0);
+    do {
+        for (size_t i = 0; i < literals.size(); ++i) {
+            if (chosen[i]) { sink(-literals[i]); }
+        }
+        if (activation != 0) { sink(-activation); }
+        sink(0);
+    } while (std::ranges::prev_permutation(chosen).found);
+}
+
+void cardinality_encoder::sequential_counter(std::span<const int> literals, int bound) {
+    // counter[j] is true if at least j + 1 of the literals seen so far are
+    std::vector<int> counter(bound), previous(bound);
+    int size = static_cast<int>(literals.size());
+    for (int i = 0; i < size; ++i) {
+        int literal = literals[i];
+        if (i > 0) { add_clause({-literal, -previous[bound - 1]}); }
+        if (i == size - 1) { break; }
+        for (int& output : counter) { output = ++*variable_count; }
+        add_clause({-literal, counter[0]});
+        if (i == 0) {
+            for (int j = 1; j < bound; ++j) { add_clause({-counter[j]}); }
+        } else {
+            add_clause({-previous[0], counter[0]});
+            for (int j = 1; j < bound; ++j) {
+                add_clause({-literal, -previous[j - 1], counter[j]});
+                add_clause({-previous[j], counter[j]});
+            }
+        }
+        std::swap(counter, previous);
+    }
+}
+
+std::vector<int> cardinality_encoder::totalizer(std::span<const int> literals, int limit) {
+    if (literals.size() == 1) { return {literals[0]}; }
+    size_t middle = literals.size() / 2;
+    std::vector<int> left = totalizer(literals.first(middle), limit);
+    std::vector<int> right = totalizer(literals.subspan(middle), limit);
+    std::vector<int> sum(std::min(static_cast<int>(left.size() + right.size()), limit));
+    for (int& output : sum) { output = ++*variable_count; }
+    // Output i + j - 1 is true if at least i of the left and j of the right inputs are
+    for (int i = 0; i <= static_cast<int>(left.size()); ++i) {
+        for (int j = 0; j <= static_cast<int>(right.size()) && i + j <= static_cast<int>(sum.size()); ++j) {
+            if (i == 0 && j == 0) { continue; }
+            if (i == 0) {
+                add_clause({-right[j - 1], sum[j - 1]});
+            } else if (j == 0) {
+                add_clause({-left[i - 1], sum[i - 1]});
+            } else {
+                add_clause({-left[i - 1], -right[j - 1], sum[i + j - 1]});
+            }
+        }
+    }
+    return sum;
+}
+
+std::pair<int, int> cardinality_encoder::comparator(int a, int b) {
+    if (a == false_literal) { return {b, false_literal}; }
+    if (b == false_literal) { return {a, false_literal}; }
+    int maximum = ++*variable_count;
+    int minimum = ++*variable_count;
+    add_clause({-a, maximum});
+    add_clause({-b, maximum});
+    add_clause({-a, -b, minimum});
+    return {maximum, minimum};
+}
+
+namespace {
+    std::vector<int> every_second(const std::vector<int>& a, size_t first) {
+        std::vector<int> result;
+        for (size_t i = first; i < a.size(); i += 2) { result.push_back(a[i]); }
+        return result;
+    }
+}
+
+std::vector<int> cardinality_encoder::half_merge(const std::vector<int>& a, const std::vector<int>& b) {
+    size_t size = a.size();
+    if (size == 1) {
+        auto [maximum, minimum] = comparator(a[0], b[0]);
+        return {maximum, minimum};
+    }
+    std::vector<int> odd = half_merge(every_second(a, 0), every_second(b, 0));
+    std::vector<int> even = half_merge(every_second(a, 1), every_second(b, 1));
+    std::vector<int> result(2 * size);
+    result.front() = odd.front();
+    result.back() = even.back();
+    for (size_t i = 1; i < size; ++i) {
+        std::tie(result[2 * i - 1], result[2 * i]) = comparator(odd[i], even[i - 1]);
+    }
+    return result;
+}
+
+std::vector<int> cardinality_encoder::half_sort(const std::vector<int>& a) {
+    if (a.size() == 1) { return a; }
+    size_t middle = a.size() / 2;
+    return half_merge(half_sort({a.begin(), a.begin() + middle}), half_sort({a.begin() + middle, a.end()}));
+}
+
+std::vector<int> cardinality_encoder::simplified_merge(const std::vector<int>& a, const std::vector<int>& b) {
+    size_t size = a.size();
+    if (size == 1) {
+        auto [maximum, minimum] = comparator(a[0], b[0]);
+        return {maximum, minimum};
+    }
+    std::vector<int> odd = simplified_merge(every_second(a, 0), every_second(b, 0));
+    std::vector<int> even = simplified_merge(every_second(a, 1), every_second(b, 1));
+    std::vector<int> result(size + 1);
+    result.front() = odd.front();
+    for (size_t i = 1; i <= size / 2; ++i) {
+        std::tie(result[2 * i - 1], result[2 * i]) = comparator(odd[i], even[i - 1]);
+    }
+    return result;
+}
+
+std::vector<int> cardinality_encoder::cardinality_network(const std::vector<int>& a, int limit) {
+    if (static_cast<int>(a.size()) == limit) { return half_sort(a); }
+    std::vector<int> first = half_sort({a.begin(), a.begin() + limit});
+    std::vector<int> rest = cardinality_network({a.begin() + limit, a.end()}, limit);
+    std::vector<int> result = simplified_merge(first, rest);
+    result.resize(limit);
+    return result;
+}
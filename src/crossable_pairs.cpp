@@ -0,0 +1,29 @@
+#include "crossable_pairs.h"
+
+crossable_pairs_t::crossable_pairs_t(const graph_t& graph) : offsets(num_edges(graph) + 1, 0) {
+    std::vector<edge_t> by_index(num_edges(graph));
+    for (edge_t edge : boost::make_iterator_range(boost::edges(graph))) {
+        by_index[get(boost::edge_index, graph, edge)] = edge;
+    }
+
+    for (size_t first = 0; first < by_index.size(); ++first) {
+        vertex_t u = source(by_index[first], graph);
+        vertex_t v = target(by_index[first], graph);
+        for (size_t second = first + 1; second < by_index.size(); ++second) {
+            vertex_t s = source(by_index[second], graph);
+            vertex_t t = target(by_index[second], graph);
+            if (u == s || u == t || v == s || v == t) { continue; }
+            pairs.emplace_back(by_index[first], by_index[second]);
+            ++offsets[first + 1];
+            ++offsets[second + 1];
+        }
+    }
+
+    for (size_t edge = 0; edge < by_index.size(); ++edge) { offsets[edge + 1] += offsets[edge]; }
+    edge_pairs.resize(2 * pairs.size());
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (int pair = 0; pair < size(); ++pair) {
+        edge_pairs[next[get(boost::edge_index, graph, pairs[pair].first)]++] = pair;
+        edge_pairs[next[get(boost::edge_index, graph, pairs[pair].second)]++] = pair;
+    }
+}
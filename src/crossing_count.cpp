@@ -0,0 +1,99 @@
+#include <algorithm>
+#include "crossing_count.h"
+
+void crossing_counter::count(std::span<const chord_t> chords, std::span<int> counts) {
+    low.resize(chords.size());
+    high.resize(chords.size());
+    for (size_t i = 0; i < chords.size(); ++i) {
+        low[i] = std::min(chords[i].first, chords[i].second);
+        high[i] = std::max(chords[i].first, chords[i].second);
+    }
+    if (chords.size() <= pairwise_limit) {
+        count_pairwise(counts);
+    } else {
+        count_sweep(counts);
+    }
+}
+
+void crossing_counter::count_pairwise(std::span<int> counts) {
+    const int* lows = low.data();
+    const int* highs = high.data();
+    int size = static_cast<int>(low.size());
+    for (int i = 0; i < size; ++i) {
+        int chord_low = lows[i];
+        int chord_high = highs[i];
+        int crossings = 0;
+        for (int j = 0; j < size; ++j) {
+            crossings += ((chord_low < lows[j]) & (lows[j] < chord_high) & (chord_high < highs[j])) |
+                ((lows[j] < chord_low) & (chord_low < highs[j]) & (highs[j] < chord_high));
+        }
+        counts[i] = crossings;
+    }
+}
+
+void crossing_counter::count_sweep(std::span<int> counts) {
+    int size = static_cast<int>(low.size());
+    int min_position = *std::ranges::min_element(low);
+    int range = *std::ranges::max_element(high) - min_position + 1;
+    if (range <= 4 * size) {
+        for (int i = 0; i < size; ++i) {
+            low[i] -= min_position;
+            high[i] -= min_position;
+        }
+    } else {
+        positions.assign(low.begin(), low.end());
+        positions.insert(positions.end(), high.begin(), high.end());
+        std::ranges::sort(positions);
+        positions.erase(std::ranges::unique(positions).begin(), positions.end());
+        for (int i = 0; i < size; ++i) {
+            low[i] = static_cast<int>(std::ranges::lower_bound(positions, low[i]) - positions.begin());
+            high[i] = static_cast<int>(std::ranges::lower_bound(positions, high[i]) - positions.begin());
+        }
+        range = static_cast<int>(positions.size());
+    }
+
+    // Fenwick tree over the positions, index p + 1 holds position p
+    auto add = [&](int position) {
+        for (++position; position <= range; position += position & -position) { ++fenwick[position]; }
+    };
+    // Number of inserted positions smaller than the given one
+    auto below = [&](int position) {
+        int sum = 0;
+        for (; position > 0; position -= position & -position) { sum += fenwick[position]; }
+        return sum;
+    };
+    // Number of inserted positions strictly between the ends of chord i
+    auto inside = [&](int i) { return low[i] < high[i] ? below(high[i]) - below(low[i] + 1) : 0; };
+
+    // Chords ending after chord i whose low end lies inside it. Chords are
+    // processed by decreasing high end, those with the same end are queried
+    // before any of them is inserted.
+    sort_by_position(high, range);
+    fenwick.assign(range + 1, 0);
+    for (int end = size; end > 0;) {
+        int begin = end;
+        while (begin > 0 && high[order[begin - 1]] == high[order[end - 1]]) { --begin; }
+        for (int k = begin; k < end; ++k) { counts[order[k]] = inside(order[k]); }
+        for (int k = begin; k < end; ++k) { add(low[order[k]]); }
+        end = begin;
+    }
+
+    // Chords starting before chord i whose high end lies inside it
+    sort_by_position(low, range);
+    fenwick.assign(range + 1, 0);
+    for (int begin = 0, end = 0; begin < size; begin = end) {
+        for (end = begin; end < size && low[order[end]] == low[order[begin]]; ++end) {
+            counts[order[end]] += inside(order[end]);
+        }
+        for (int k = begin; k < end; ++k) { add(high[order[k]]); }
+    }
+}
+
+void crossing_counter::sort_by_position(const std::vector<int>& keys, int range) {
+    // Counting sort, positions lie in [0, range)
+    fenwick.assign(range + 1, 0);
+    for (int key : keys) { ++fenwick[key + 1]; }
+    for (int position = 0; position < range; ++position) { fenwick[position + 1] += fenwick[position]; }
+    order.resize(keys.size());
+    for (int i = 0; i < static_cast<int>(keys.size()); ++i) { order[fenwick[keys[i]]++] = i; }
+}
@@ -0,0 +1,51 @@
+#include <algorithm>
+#include "crossing_count.h"
+#include "crossing_search.h"
+
+int search_crossing_number(search_strategy_t strategy, int start, int lower_bound, int upper_bound,
+                           const std::function<bool(int)>& is_drawable) {
+    int low = strategy == LINEAR_SEARCH ? start : std::max(start, lower_bound);
+    if (strategy != GALLOPING_SEARCH) {
+        for (int k = low; k < upper_bound; ++k) {
+            if (is_drawable(k)) { return k; }
+        }
+        return std::max(low, upper_bound);
+    }
+
+    // Probe low, low + 1, low + 3, low + 7, ... until a drawable value is found,
+    // then bisect the gap to the last failed probe
+    int high = std::max(low, upper_bound);
+    int origin = low;
+    for (int step = 1; low < high; step *= 2) {
+        int probe = std::min(origin + step - 1, high - 1);
+        if (is_drawable(probe)) {
+            high = probe;
+            break;
+        }
+        low = probe + 1;
+    }
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        if (is_drawable(middle)) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+    return high;
+}
+
+int local_crossing_number(const graph_t& graph, const std::vector<vertex_t>& order) {
+    std::vector<int> positions(num_vertices(graph));
+    for (int i = 0; i < static_cast<int>(order.size()); ++i) {
+        positions[get(boost::vertex_index, graph, order[i])] = i;
+    }
+    std::vector<chord_t> chords;
+    for (edge_t edge : make_iterator_range(edges(graph))) {
+        chords.emplace_back(positions[get(boost::vertex_index, graph, source(edge, graph))],
+                            positions[get(boost::vertex_index, graph, target(edge, graph))]);
+    }
+    std::vector<int> crossings(chords.size());
+    crossing_counter().count(chords, crossings);
+    return crossings.empty() ? 0 : *std::ranges::max_element(crossings);
+}
@@ -1,53 +1,78 @@
 #include <boost/graph/connected_components.hpp>
 #include <boost/graph/biconnected_components.hpp>
 #include <boost/graph/bipartite.hpp>
+#include "crossing_search.h"
 #include "dp_solver.h"
+#include "heuristic_solver.h"
+#include "lower_bound.h"
 
+#include <atomic>
+#include <limits>
 #include <numeric>
 #include <ranges>
 
-bool dp_solver::check_input() {
+template <class vertex_set_t>
+bool basic_dp_solver<vertex_set_t>::check_input() {
 #ifndef PERF_TEST
     if (static_cast<int>(biconnected_components(graph, boost::dummy_property_map())) != 1) {
-        std::cout << "WARNING: The input graph is not biconnected. Use bicomponent_solver<dp_solver>" << std::endl;
+        std::cerr << "WARNING: The input graph is not biconnected. Use bicomponent_solver<dp_solver>" << std::endl;
     }
 #endif
-    if (boost::num_vertices(graph) > 64) {
+    if (static_cast<int>(boost::num_vertices(graph)) > traits::capacity) {
 #ifndef PERF_TEST
-        std::cout << "ERROR: The input graph is too big for dp_solver." << std::endl;
+        std::cerr << "ERROR: The input graph is too big for dp_solver." << std::endl;
 #endif
         return false;
     }
     return true;
 }
 
-bool dp_solver::solve() {
+template <class vertex_set_t>
+bool basic_dp_solver<vertex_set_t>::solve() {
     if (!check_input()) { return false; }
-    vertex_order.clear();
-    vertex_order.insert(vertex_order.end(), vertices(graph).first, vertices(graph).second);
+    // The heuristic drawing gives the upper bound, it is replaced by the one
+    // restored from the tables of every successful call. The tables only grow
+    // with the crossing number and are rebuilt when it decreases.
+    int upper_bound = heuristic_drawing(graph, options, vertex_order);
     if (vertex_order.size() <= 3) {
         return true;
     }
 
-    initialise_table();
-
-    while (!is_drawable()) {
-        add_table_entries(++crossing_number);
-    }
-
+    int lower_bound = local_crossing_lower_bound(graph);
+    int table_crossing_number = -1;
+    thread_pool pool(options.threads);
+    crossing_number = search_crossing_number(options.search_strategy, crossing_number, lower_bound, upper_bound,
+                                             [&](int k) {
+        ++oracle_calls;
+        crossing_number = k;
+        if (table_crossing_number < 0 || k < table_crossing_number) {
+            initialise_table();
+            table_crossing_number = k;
+        }
+        while (table_crossing_number < k) { add_table_entries(++table_crossing_number); }
+        return is_drawable(pool) && restore_drawing();
+    });
 #ifndef NDEBUG
-    std::cout << "Entries in all dp_tables: " << misses << "\n"
+    std::cerr << "Entries in all dp_tables: " << misses << "\n"
         "Duplicates not inserted in tables: " << hits << std::endl;
-    print_table();
+    if (table_crossing_number >= 0) { print_table(); }
 #endif
+    return true;
+}
 
+template <class vertex_set_t>
+bool basic_dp_solver<vertex_set_t>::restore_drawing() {
     int num_vertices = static_cast<int>(boost::num_vertices(graph));
     for (int v_index = 0; v_index < num_vertices; ++v_index) {
         for (int u_index = v_index + 1; u_index < num_vertices; ++u_index) {
-            size_t right_side = (1 << num_vertices) - 1;
-            right_side ^= (1 << u_index) | (1 << v_index);
-            if (dp_table[v_index][u_index].contains(right_side) && !dp_table[v_index][u_index][right_side].empty()) {
-                vertex_order = dp_table[v_index][u_index][right_side].begin()->second.vertex_order;
+            vertex_set_t right_side{};
+            for (int w_index = 0; w_index < num_vertices; ++w_index) {
+                if (w_index != v_index && w_index != u_index) { right_side |= traits::singleton(w_index); }
+            }
+            auto cell = dp_table[v_index][u_index].find(right_side);
+            if (cell != dp_table[v_index][u_index].end() && !cell->second.entries.empty()) {
+                vertex_order.clear();
+                restore_vertex_order(vertex_order, {v_index, u_index}, cell->second.entries.front().begin, false);
                 vertex_order.push_back(u_index);
                 vertex_order.push_back(v_index);
                 return true;
@@ -55,26 +80,52 @@ bool dp_solver::solve() {
         }
     }
 #ifndef PERF_TEST
-    std::cout << "Something went wrong" << std::endl;
+    std::cerr << "Something went wrong" << std::endl;
 #endif
     return false;
 }
 
-void dp_solver::fill_edge_order(std::vector<edge_t>& order_vector,
-                                const std::vector<edge_t>& edges,
-                                const std::vector<std::pair<int, int>>& edge_order) {
+template <class vertex_set_t>
+std::span<const edge_t> basic_dp_solver<vertex_set_t>::range_edges(const edge_range_t& range) const {
+    return {piercing_edges_pool.data() + range.begin, range.size};
+}
+
+template <class vertex_set_t>
+const typename basic_dp_solver<vertex_set_t>::side_edges_map_t&
+basic_dp_solver<vertex_set_t>::right_sides(vertex_t v, vertex_t u, int size) const {
+    static const side_edges_map_t no_sides;
+    const auto& link_sides = dp_table_initialisation[v][u];
+    return size < static_cast<int>(link_sides.size()) ? link_sides[size] : no_sides;
+}
+
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::fill_edge_order(std::vector<edge_t>& order_vector,
+                                                    std::span<const edge_t> edges,
+                                                    const edge_order_signature_t& edge_order) const {
+    order_vector.resize(edges.size());
+    for (int i = 0; i < static_cast<int>(edges.size()); i++) {
+        order_vector[i] = edges[edge_order.get(i, wide_edges_pool).first];
+    }
+}
+
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::fill_edge_order(std::vector<edge_t>& order_vector,
+                                                    std::span<const edge_t> edges,
+                                                    const std::vector<std::pair<int, int>>& edge_order) {
     order_vector.resize(edges.size());
     for (int i = 0; i < static_cast<int>(edges.size()); i++) {
         order_vector[i] = edges[edge_order[i].first];
     }
 }
 
-bool dp_solver::check_triangle_consistency(const std::ranges::range auto& edges,
-                                           triangle_vertex_type_t edge_type,
-                                           triangle_vertex_type_t prev_type) {
+template <class vertex_set_t>
+bool basic_dp_solver<vertex_set_t>::check_triangle_consistency(worker_t& worker,
+                                                               const std::ranges::range auto& edges,
+                                                               triangle_vertex_type_t edge_type,
+                                                               triangle_vertex_type_t prev_type) {
     std::pair prev_trg{prev_type, 0};
     for (const edge_t& edge : edges) {
-        const auto& triangle_edge = triangle_edges_map[get(edge_index_map, edge)];
+        const auto& triangle_edge = worker.triangle_edges_map[get(edge_index_map, edge)];
         auto src = triangle_edge.first;
         auto trg = triangle_edge.second;
         if (src.first != edge_type) {
@@ -89,243 +140,548 @@ bool dp_solver::check_triangle_consistency(const std::ranges::range auto& edges,
     return true;
 }
 
-void dp_solver::add_triangle_edges(const std::ranges::range auto& edges,
-                                   vertex_t opposite_vertex,
-                                   triangle_vertex_type_t opposite_type,
-                                   triangle_vertex_type_t common_type) {
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::add_triangle_edges(worker_t& worker,
+                                                       const std::ranges::range auto& edges,
+                                                       vertex_t opposite_vertex,
+                                                       triangle_vertex_type_t opposite_type,
+                                                       triangle_vertex_type_t common_type) {
     for (int i = 0; i < static_cast<int>(edges.size()); ++i) {
         int edge_index = get(edge_index_map, edges[i]);
         if (source(edges[i], graph) == opposite_vertex ||
             target(edges[i], graph) == opposite_vertex) {
-            triangle_edges_map[edge_index].second = {opposite_type, 0};
+            worker.triangle_edges_map[edge_index].second = {opposite_type, 0};
         }
-        if (triangle_edges_map[edge_index].first.first == NONE) {
-            triangle_edges_map[edge_index].first = {common_type, i};
-            triangle_edges.push_back(edge_index);
+        if (worker.triangle_edges_map[edge_index].first.first == NONE) {
+            worker.triangle_edges_map[edge_index].first = {common_type, i};
+            worker.triangle_edges.push_back(edge_index);
         } else {
-            triangle_edges_map[edge_index].second = {common_type, i};
+            worker.triangle_edges_map[edge_index].second = {common_type, i};
         }
     }
 }
 
-bool dp_solver::count_triangle_intersections(const std::ranges::range auto& part_a_edges,
-                                             const std::ranges::range auto& part_b_edges,
-                                             const std::ranges::range auto& piercing_edges,
-                                             vertex_t split_vertex) {
+template <class vertex_set_t>
+chord_t basic_dp_solver<vertex_set_t>::triangle_chord(const triangle_edge_t& triangle_edge) const {
+    // Indices within a type are below the number of edges, so the positions keep the order of the vertices
+    int stride = static_cast<int>(num_edges(graph)) + 1;
+    return {triangle_edge.first.first * stride + triangle_edge.first.second,
+            triangle_edge.second.first * stride + triangle_edge.second.second};
+}
+
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::count_triangle_crossings(worker_t& worker,
+                                                             const std::ranges::range auto& edge_indices) {
+    worker.triangle_chords.clear();
+    for (int edge_index : edge_indices) {
+        worker.triangle_chords.push_back(triangle_chord(worker.triangle_edges_map[edge_index]));
+    }
+    worker.triangle_crossings.resize(worker.triangle_chords.size());
+    worker.crossings.count(worker.triangle_chords, worker.triangle_crossings);
+}
+
+template <class vertex_set_t>
+bool basic_dp_solver<vertex_set_t>::count_triangle_intersections(worker_t& worker,
+                                                                 const std::ranges::range auto& part_a_edges,
+                                                                 const std::ranges::range auto& part_b_edges,
+                                                                 const std::ranges::range auto& piercing_edges,
+                                                                 vertex_t split_vertex) {
     auto default_entry = std::make_pair(std::make_pair(NONE, 0), std::make_pair(NONE, 0));
-    std::ranges::fill(triangle_edges_map, default_entry);
-    triangle_edges.clear();
+    std::ranges::fill(worker.triangle_edges_map, default_entry);
+    worker.triangle_edges.clear();
 
-    add_triangle_edges(part_a_edges, active_link.second, LINK_TRG, HELPER_PART_A);
-    add_triangle_edges(part_b_edges, active_link.first, LINK_SRC, HELPER_PART_B);
-    add_triangle_edges(piercing_edges, split_vertex, SPLIT, HELPER_PIERCE);
+    add_triangle_edges(worker, part_a_edges, worker.active_link.second, LINK_TRG, HELPER_PART_A);
+    add_triangle_edges(worker, part_b_edges, worker.active_link.first, LINK_SRC, HELPER_PART_B);
+    add_triangle_edges(worker, piercing_edges, split_vertex, SPLIT, HELPER_PIERCE);
 
-    if (!check_triangle_consistency(part_a_edges, HELPER_PART_A, LINK_SRC)) return false;
-    if (!check_triangle_consistency(part_b_edges, HELPER_PART_B, SPLIT)) return false;
+    if (!check_triangle_consistency(worker, part_a_edges, HELPER_PART_A, LINK_SRC)) return false;
+    if (!check_triangle_consistency(worker, part_b_edges, HELPER_PART_B, SPLIT)) return false;
 
-    auto [link, ok] = edge(active_link.first, active_link.second, graph);
+    auto [link, ok] = edge(worker.active_link.first, worker.active_link.second, graph);
     if (ok) {
         int link_index = get(edge_index_map, link);
-        triangle_edges.push_back(link_index);
-        triangle_edges_map[link_index] = {{LINK_SRC, 0}, {LINK_TRG, 0}};
-    }
-
-    for (int edge_index : triangle_edges) {
-        int intersections = 0;
-        auto edge_src = triangle_edges_map[edge_index].first;
-        auto edge_trg = triangle_edges_map[edge_index].second;
-        if (edge_src.first > edge_trg.first) { std::swap(edge_src, edge_trg); }
-        for (int other_index : triangle_edges) {
-            auto other_src = triangle_edges_map[other_index].first;;
-            auto other_trg = triangle_edges_map[other_index].second;;
-            if (other_src.first > other_trg.first) { std::swap(other_src, other_trg); }
-
-            bool src_between = edge_src < other_src && other_src < edge_trg;
-            bool trg_between = edge_src < other_trg && other_trg < edge_trg;
-            intersections += (src_between && other_trg > edge_trg) ||
-                (trg_between && other_src < edge_src);
-        }
-        edges_intersection_count[edge_index] += intersections;
-        if (edges_intersection_count[edge_index] > crossing_number) {
+        worker.triangle_edges.push_back(link_index);
+        worker.triangle_edges_map[link_index] = {{LINK_SRC, 0}, {LINK_TRG, 0}};
+    }
+
+    count_triangle_crossings(worker, worker.triangle_edges);
+    for (size_t i = 0; i < worker.triangle_edges.size(); ++i) {
+        int edge_index = worker.triangle_edges[i];
+        worker.edges_intersection_count[edge_index] += worker.triangle_crossings[i];
+        if (worker.edges_intersection_count[edge_index] > crossing_number) {
+            worker.min_exceeded_count = std::min(worker.min_exceeded_count,
+                                                 worker.edges_intersection_count[edge_index]);
             return false;
         }
     }
     return true;
 }
 
-bool dp_solver::check_inner_triangle(vertex_t split_vertex) {
-    if (split_vertex < active_link.first) {
-        if (split_vertex > active_link.second) {
+template <class vertex_set_t>
+bool basic_dp_solver<vertex_set_t>::check_inner_triangle(worker_t& worker, vertex_t split_vertex) {
+    if (split_vertex < worker.active_link.first) {
+        if (split_vertex > worker.active_link.second) {
             return count_triangle_intersections(
-                part_a_edges_order | std::views::reverse,
-                part_b_edges_order | std::views::reverse,
-                piercing_edges_order | std::views::reverse,
+                worker,
+                worker.part_a_edges_order | std::views::reverse,
+                worker.part_b_edges_order | std::views::reverse,
+                worker.piercing_edges_order | std::views::reverse,
                 split_vertex
             );
         }
         return count_triangle_intersections(
-            part_a_edges_order | std::views::reverse,
-            part_b_edges_order,
-            piercing_edges_order | std::views::reverse,
+            worker,
+            worker.part_a_edges_order | std::views::reverse,
+            worker.part_b_edges_order,
+            worker.piercing_edges_order | std::views::reverse,
             split_vertex
         );
     }
-    if (split_vertex > active_link.second) {
+    if (split_vertex > worker.active_link.second) {
         return count_triangle_intersections(
-            part_a_edges_order,
-            part_b_edges_order | std::views::reverse,
-            piercing_edges_order | std::views::reverse,
+            worker,
+            worker.part_a_edges_order,
+            worker.part_b_edges_order | std::views::reverse,
+            worker.piercing_edges_order | std::views::reverse,
             split_vertex
         );
     }
     return count_triangle_intersections(
-        part_a_edges_order,
-        part_b_edges_order,
-        piercing_edges_order | std::views::reverse,
+        worker,
+        worker.part_a_edges_order,
+        worker.part_b_edges_order,
+        worker.piercing_edges_order | std::views::reverse,
         split_vertex
     );
 }
 
-void dp_solver::combine_vertex_order(vertex_t split_vertex,
-                                     const table_entry_t& part_a_entry,
-                                     const table_entry_t& part_b_entry) {
-    combined_entry.vertex_order.clear();
-    if (split_vertex < active_link.first) {
-        combined_entry.vertex_order.insert(combined_entry.vertex_order.end(),
-                                           part_a_entry.vertex_order.rbegin(),
-                                           part_a_entry.vertex_order.rend());
-    } else {
-        combined_entry.vertex_order.insert(combined_entry.vertex_order.end(),
-                                           part_a_entry.vertex_order.begin(),
-                                           part_a_entry.vertex_order.end());
-    }
-    combined_entry.vertex_order.push_back(split_vertex);
-    if (split_vertex > active_link.second) {
-        combined_entry.vertex_order.insert(combined_entry.vertex_order.end(),
-                                           part_b_entry.vertex_order.rbegin(),
-                                           part_b_entry.vertex_order.rend());
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::restore_vertex_order(std::vector<vertex_t>& order,
+                                                         std::pair<vertex_t, vertex_t> link,
+                                                         size_t entry_id, bool reversed) const {
+    const table_entry_t& entry = table_entries[entry_id];
+    vertex_t split_vertex = entry.split_vertex;
+    if (split_vertex == graph_t::null_vertex()) { return; }
+
+    std::pair uw_link(link.first, split_vertex);
+    std::pair vw_link(split_vertex, link.second);
+    bool part_a_reversed = reversed;
+    bool part_b_reversed = reversed;
+    if (split_vertex < link.first) {
+        std::swap(uw_link.first, uw_link.second);
+        part_a_reversed = !part_a_reversed;
+    }
+    if (split_vertex > link.second) {
+        std::swap(vw_link.first, vw_link.second);
+        part_b_reversed = !part_b_reversed;
+    }
+
+    if (!reversed) {
+        restore_vertex_order(order, uw_link, entry.part_a_entry, part_a_reversed);
+        order.push_back(split_vertex);
+        restore_vertex_order(order, vw_link, entry.part_b_entry, part_b_reversed);
     } else {
-        combined_entry.vertex_order.insert(combined_entry.vertex_order.end(),
-                                           part_b_entry.vertex_order.begin(),
-                                           part_b_entry.vertex_order.end());
+        restore_vertex_order(order, vw_link, entry.part_b_entry, part_b_reversed);
+        order.push_back(split_vertex);
+        restore_vertex_order(order, uw_link, entry.part_a_entry, part_a_reversed);
     }
 }
 
-void dp_solver::process_all_arrangements(const std::vector<edge_t>& piercing_edges,
-                                         vertex_t split_vertex, size_t right_side,
-                                         const table_entry_t& part_a_entry,
-                                         const table_entry_t& part_b_entry) {
+template <class vertex_set_t>
+bool basic_dp_solver<vertex_set_t>::insert_signature(worker_t& worker, const edge_order_signature_t& signature) {
+    if (!worker.cell_signatures.insert({signature, &worker.wide_edges})) {
+        worker.wide_edges.resize(worker.wide_edges.size() - signature.wide_size);
+#ifndef NDEBUG
+        worker.hits++;
+#endif
+        return false;
+    }
+#ifndef NDEBUG
+    worker.misses++;
+#endif
+    return true;
+}
+
+template <class vertex_set_t>
+int basic_dp_solver<vertex_set_t>::add_part_crossings(worker_t& worker,
+                                                     const table_entry_t& part_a_entry,
+                                                     const table_entry_t& part_b_entry) {
+    int max_crossings = 0;
+    std::ranges::fill(worker.edges_intersection_count, 0);
+    for (int i = 0; i < static_cast<int>(worker.part_a_edges_order.size()); i++) {
+        int edge_index = get(edge_index_map, worker.part_a_edges_order[i]);
+        worker.edges_intersection_count[edge_index] += part_a_entry.edge_order.get(i, wide_edges_pool).second;
+        max_crossings = std::max(max_crossings, worker.edges_intersection_count[edge_index]);
+    }
+    for (int i = 0; i < static_cast<int>(worker.part_b_edges_order.size()); i++) {
+        int edge_index = get(edge_index_map, worker.part_b_edges_order[i]);
+        worker.edges_intersection_count[edge_index] += part_b_entry.edge_order.get(i, wide_edges_pool).second;
+        max_crossings = std::max(max_crossings, worker.edges_intersection_count[edge_index]);
+    }
+    return max_crossings;
+}
+
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::process_all_arrangements(worker_t& worker,
+                                                             std::span<const edge_t> piercing_edges,
+                                                             vertex_t split_vertex,
+                                                             const table_entry_t& part_a_entry, size_t part_a_id,
+                                                             const table_entry_t& part_b_entry, size_t part_b_id) {
+    // The crossings brought in by the parts do not depend on the arrangement of
+    // the piercing edges, so a pair exceeding the bound is rejected as a whole
+    int part_crossings = add_part_crossings(worker, part_a_entry, part_b_entry);
+    if (part_crossings > crossing_number) {
+        worker.min_exceeded_count = std::min(worker.min_exceeded_count, part_crossings);
+        return;
+    }
+    if (options.dp_arrangements == PRUNED_ARRANGEMENTS) {
+        process_pruned_arrangements(worker, piercing_edges, split_vertex, part_a_id, part_b_id);
+        return;
+    }
     do {
-        bool ok = true;
-        fill_edge_order(piercing_edges_order, piercing_edges, combined_entry.edge_order);
-        std::ranges::fill(edges_intersection_count, 0);
-        for (int i = 0; i < static_cast<int>(part_a_edges_order.size()); i++) {
-            int edge_index = get(edge_index_map, part_a_edges_order[i]);
-            edges_intersection_count[edge_index] += part_a_entry.edge_order[i].second;
-        }
-        for (int i = 0; i < static_cast<int>(part_b_edges_order.size()); i++) {
-            int edge_index = get(edge_index_map, part_b_edges_order[i]);
-            edges_intersection_count[edge_index] += part_b_entry.edge_order[i].second;
-            if (edges_intersection_count[edge_index] > crossing_number) {
-                ok = false;
-                break;
-            }
+        fill_edge_order(worker.piercing_edges_order, piercing_edges, worker.combined_edge_order);
+        add_part_crossings(worker, part_a_entry, part_b_entry);
+        if (!check_inner_triangle(worker, split_vertex)) continue;
+
+        for (int i = 0; i < static_cast<int>(worker.piercing_edges_order.size()); i++) {
+            int edge_index = get(edge_index_map, worker.piercing_edges_order[i]);
+            worker.combined_edge_order[i].second = worker.edges_intersection_count[edge_index];
         }
-        if (!ok) { continue; }
+        auto signature = edge_order_signature_t::pack(worker.combined_edge_order, worker.wide_edges);
+        if (!insert_signature(worker, signature)) continue;
+        worker.entries.push_back({signature, split_vertex, part_a_id, part_b_id});
+    } while (std::ranges::next_permutation(worker.combined_edge_order).found);
+}
 
-        if (!check_inner_triangle(split_vertex)) continue;
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::process_pruned_arrangements(worker_t& worker,
+                                                                std::span<const edge_t> piercing_edges,
+                                                                vertex_t split_vertex,
+                                                                size_t part_a_id, size_t part_b_id) {
+    // The same triangle as in check_inner_triangle, but a piercing edge first
+    // gets its index among piercing_edges in place of its position
+    if (split_vertex < worker.active_link.first) { std::ranges::reverse(worker.part_a_edges_order); }
+    if (split_vertex > worker.active_link.second) { std::ranges::reverse(worker.part_b_edges_order); }
+    worker.triangle_edges.clear();
+    add_triangle_edges(worker, worker.part_a_edges_order, worker.active_link.second, LINK_TRG, HELPER_PART_A);
+    add_triangle_edges(worker, worker.part_b_edges_order, worker.active_link.first, LINK_SRC, HELPER_PART_B);
+    add_triangle_edges(worker, piercing_edges, split_vertex, SPLIT, HELPER_PIERCE);
+    auto [link, has_link] = edge(worker.active_link.first, worker.active_link.second, graph);
+    if (has_link) {
+        int link_index = get(edge_index_map, link);
+        worker.triangle_edges.push_back(link_index);
+        worker.triangle_edges_map[link_index] = {{LINK_SRC, 0}, {LINK_TRG, 0}};
+    }
 
-        std::string key;
-        for (int i = 0; i < static_cast<int>(piercing_edges_order.size()); i++) {
-            int edge_index = get(edge_index_map, piercing_edges_order[i]);
-            combined_entry.edge_order[i].second = edges_intersection_count[edge_index];
-            key += std::to_string(combined_entry.edge_order[i].first) +
-                "_" + std::to_string(combined_entry.edge_order[i].second) + " ";
+    int num_piercing = static_cast<int>(piercing_edges.size());
+    worker.arrangement_origins.resize(num_piercing);
+    worker.split_edges.clear();
+    for (auto& chain : worker.part_chains) { chain.clear(); }
+    for (int i = 0; i < num_piercing; ++i) {
+        auto [src, trg] = worker.triangle_edges_map[get(edge_index_map, piercing_edges[i])];
+        worker.arrangement_origins[i] = src.first == HELPER_PIERCE ? trg : src;
+        switch (worker.arrangement_origins[i].first) {
+        case HELPER_PART_A: worker.part_chains[0].push_back(i); break;
+        case HELPER_PART_B: worker.part_chains[1].push_back(i); break;
+        default: worker.split_edges.push_back(i);
         }
-        combine_vertex_order(split_vertex, part_a_entry, part_b_entry);
+    }
 
-        auto& cell = dp_table[active_link.first][active_link.second][right_side];
-        if (!cell.contains(key)) {
-            cell[key] = combined_entry;
-#ifndef NDEBUG
-                            misses++;
-                        } else {
-                            hits++;
-#endif
+    // The piercing edges leaving a part keep their order: the part check
+    // passes only if their positions decrease along the part. They are placed
+    // by increasing position, so the last one along the part comes first.
+    for (auto& chain : worker.part_chains) {
+        std::ranges::sort(chain, [&](int lhs, int rhs) {
+            return worker.arrangement_origins[lhs] > worker.arrangement_origins[rhs];
+        });
+        for (int position = 0; position < static_cast<int>(chain.size()); ++position) {
+            auto& triangle_edge = worker.triangle_edges_map[get(edge_index_map, piercing_edges[chain[position]])];
+            triangle_edge.second = {HELPER_PIERCE, position};
+        }
+    }
+    bool consistent = check_triangle_consistency(worker, worker.part_a_edges_order, HELPER_PART_A, LINK_SRC) &&
+        check_triangle_consistency(worker, worker.part_b_edges_order, HELPER_PART_B, SPLIT);
+
+    // Crossings with edges that are not piercing do not depend on the order of the
+    // piercing edges, as all the piercing edges end after every other triangle vertex.
+    // The crossings among the piercing edges themselves are counted when placing them.
+    worker.arrangement_crossings.assign(num_piercing, 0);
+    if (consistent) {
+        count_triangle_crossings(worker, piercing_edges | std::views::transform([&](const edge_t& edge) {
+            return static_cast<int>(get(edge_index_map, edge));
+        }));
+        for (int i = 0; i < num_piercing; ++i) {
+            worker.edges_intersection_count[get(edge_index_map, piercing_edges[i])] -= worker.triangle_crossings[i];
+        }
+        count_triangle_crossings(worker, worker.triangle_edges);
+    }
+    for (size_t i = 0; consistent && i < worker.triangle_edges.size(); ++i) {
+        int edge_index = worker.triangle_edges[i];
+        const triangle_edge_t& triangle_edge = worker.triangle_edges_map[edge_index];
+        bool piercing = triangle_edge.first.first == HELPER_PIERCE || triangle_edge.second.first == HELPER_PIERCE;
+        worker.edges_intersection_count[edge_index] += worker.triangle_crossings[i];
+        if (!piercing && worker.edges_intersection_count[edge_index] > crossing_number) {
+            worker.min_exceeded_count = std::min(worker.min_exceeded_count,
+                                                 worker.edges_intersection_count[edge_index]);
+            consistent = false;
+        }
+    }
+    for (int i = 0; consistent && i < num_piercing; ++i) {
+        worker.arrangement_crossings[i] = worker.edges_intersection_count[get(edge_index_map, piercing_edges[i])];
+    }
+
+    if (consistent) {
+        worker.arrangement.resize(num_piercing);
+        worker.arrangement_placed.assign(num_piercing, false);
+        size_t chain_positions[2] = {0, 0};
+        place_arrangement_edge(worker, 0, chain_positions, split_vertex, part_a_id, part_b_id);
+    }
+
+    for (int edge_index : worker.triangle_edges) {
+        worker.triangle_edges_map[edge_index] = {{NONE, 0}, {NONE, 0}};
+    }
+}
+
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::place_arrangement_edge(worker_t& worker, int position, size_t chain_positions[2],
+                                                           vertex_t split_vertex, size_t part_a_id, size_t part_b_id) {
+    int num_piercing = static_cast<int>(worker.arrangement.size());
+    if (position == num_piercing) {
+        // Positions in the triangle run against the order of the piercing edges along the link
+        auto signature = edge_order_signature_t::pack(worker.arrangement | std::views::reverse, worker.wide_edges);
+        if (!insert_signature(worker, signature)) { return; }
+        worker.entries.push_back({signature, split_vertex, part_a_id, part_b_id});
+        return;
+    }
+
+    auto try_edge = [&](int edge) {
+        // Two piercing edges cross iff the one placed first leaves the triangle
+        // before the other, so the crossings of an edge are known once it is placed
+        const triangle_vertex_t& origin = worker.arrangement_origins[edge];
+        int crossings = worker.arrangement_crossings[edge];
+        for (int other = 0; other < num_piercing; ++other) {
+            if (other == edge) { continue; }
+            const triangle_vertex_t& other_origin = worker.arrangement_origins[other];
+            crossings += worker.arrangement_placed[other] ? other_origin < origin : origin < other_origin;
+        }
+        if (crossings > crossing_number) {
+            worker.min_exceeded_count = std::min(worker.min_exceeded_count, crossings);
+            return;
         }
-    } while (std::ranges::next_permutation(combined_entry.edge_order).found);
+        worker.arrangement[position] = {edge, crossings};
+        worker.arrangement_placed[edge] = true;
+        place_arrangement_edge(worker, position + 1, chain_positions, split_vertex, part_a_id, part_b_id);
+        worker.arrangement_placed[edge] = false;
+    };
+
+    for (int chain = 0; chain < 2; ++chain) {
+        if (chain_positions[chain] == worker.part_chains[chain].size()) { continue; }
+        ++chain_positions[chain];
+        try_edge(worker.part_chains[chain][chain_positions[chain] - 1]);
+        --chain_positions[chain];
+    }
+    for (int edge : worker.split_edges) {
+        if (!worker.arrangement_placed[edge]) { try_edge(edge); }
+    }
+}
+
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::process_candidate(worker_t& worker,
+                                                     std::span<const edge_t> piercing_edges, vertex_t split_vertex,
+                                                     const edge_range_t& part_a_edges, size_t part_a_id,
+                                                     const edge_range_t& part_b_edges, size_t part_b_id) {
+    const table_entry_t& part_a_entry = table_entries[part_a_id];
+    const table_entry_t& part_b_entry = table_entries[part_b_id];
+    fill_edge_order(worker.part_a_edges_order, range_edges(part_a_edges), part_a_entry.edge_order);
+    fill_edge_order(worker.part_b_edges_order, range_edges(part_b_edges), part_b_entry.edge_order);
+    worker.combined_edge_order.resize(piercing_edges.size());
+    for (int i = 0; i < static_cast<int>(piercing_edges.size()); i++) {
+        worker.combined_edge_order[i].first = i;
+    }
+    worker.min_exceeded_count = std::numeric_limits<int>::max();
+    process_all_arrangements(worker, piercing_edges, split_vertex,
+                             part_a_entry, part_a_id, part_b_entry, part_b_id);
+    if (worker.min_exceeded_count != std::numeric_limits<int>::max()) {
+        worker.cut_off_candidates.push_back({split_vertex, part_a_edges, part_a_id, part_b_edges, part_b_id,
+                                             worker.min_exceeded_count});
+    }
 }
 
-void dp_solver::process_split(size_t right_side, int right_size, const std::vector<edge_t>& piercing_edges,
-                              vertex_t split_vertex) {
-    std::pair uw_link(active_link.first, split_vertex);
-    std::pair vw_link(split_vertex, active_link.second);
-    if (split_vertex < active_link.first) { std::swap(uw_link.first, uw_link.second); }
-    if (split_vertex > active_link.second) { std::swap(vw_link.first, vw_link.second); }
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::process_split(worker_t& worker, const vertex_set_t& right_side, int right_size,
+                                                 std::span<const edge_t> piercing_edges, vertex_t split_vertex,
+                                                 bool new_cell) {
+    std::pair uw_link(worker.active_link.first, split_vertex);
+    std::pair vw_link(split_vertex, worker.active_link.second);
+    if (split_vertex < worker.active_link.first) { std::swap(uw_link.first, uw_link.second); }
+    if (split_vertex > worker.active_link.second) { std::swap(vw_link.first, vw_link.second); }
+    const auto& uw_cells = dp_table[uw_link.first][uw_link.second];
+    const auto& vw_cells = dp_table[vw_link.first][vw_link.second];
     for (int part_a_size = 0; part_a_size < right_size; part_a_size++) {
-        for (const auto& init_entry : dp_table_initialisation[uw_link.first][uw_link.second][part_a_size]) {
-            size_t part_a = init_entry.first;
-            const auto& part_a_edges = init_entry.second;
+        for (const auto& [part_a, part_a_range] : right_sides(uw_link.first, uw_link.second, part_a_size)) {
             if ((part_a & right_side) != part_a) { continue; }
             int part_b_size = right_size - part_a_size - 1;
-            size_t part_b = right_side ^ part_a ^ 1 << split_vertex;
-            if (!dp_table[uw_link.first][uw_link.second].contains(part_a) ||
-                !dp_table[vw_link.first][vw_link.second].contains(part_b)) {
+            vertex_set_t part_b = right_side ^ part_a ^ traits::singleton(split_vertex);
+            auto part_a_cell = uw_cells.find(part_a);
+            auto part_b_cell = vw_cells.find(part_b);
+            if (part_a_cell == uw_cells.end() || part_b_cell == vw_cells.end()) {
                 continue;
             }
-            const auto& vw_index = dp_table_initialisation[vw_link.first][vw_link.second][part_b_size];
-            if (!vw_index.contains(part_b)) { continue; }
-            const auto& part_b_edges = vw_index.at(part_b);
-
-            for (const auto& part_a_entry : dp_table[uw_link.first][uw_link.second][part_a] | std::views::values) {
-                fill_edge_order(part_a_edges_order, part_a_edges, part_a_entry.edge_order);
-                for (const auto& part_b_entry : dp_table[vw_link.first][vw_link.second][part_b] | std::views::values) {
-                    fill_edge_order(part_b_edges_order, part_b_edges, part_b_entry.edge_order);
-                    combined_entry.edge_order.resize(piercing_edges.size());
-                    for (int i = 0; i < static_cast<int>(piercing_edges.size()); i++) {
-                        combined_entry.edge_order[i].first = i;
+            const auto& vw_index = right_sides(vw_link.first, vw_link.second, part_b_size);
+            auto part_b_range = vw_index.find(part_b);
+            if (part_b_range == vw_index.end()) { continue; }
+
+            for (const entry_range_t& part_a_block : part_a_cell->second.entries) {
+                for (size_t a = part_a_block.begin; a < part_a_block.begin + part_a_block.size; ++a) {
+                    for (const entry_range_t& part_b_block : part_b_cell->second.entries) {
+                        for (size_t b = part_b_block.begin; b < part_b_block.begin + part_b_block.size; ++b) {
+                            // Pairs of entries known in the previous iteration were already combined
+                            // for this cell. Those cut off by the crossing number are retried separately
+                            if (!new_cell && a < iteration_begin && b < iteration_begin) { continue; }
+                            process_candidate(worker, piercing_edges, split_vertex,
+                                              part_a_range, a, part_b_range->second, b);
+                        }
                     }
-                    process_all_arrangements(piercing_edges, split_vertex, right_side, part_a_entry, part_b_entry);
                 }
             }
         }
     }
 }
 
-bool dp_solver::is_drawable() {
-    dp_table.clear();
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::process_cell(worker_t& worker, level_cell_t& level_cell) {
+    const table_cell_t& cell = *level_cell.cell;
+    worker.active_link = {level_cell.v_index, level_cell.u_index};
+    worker.cell_signatures.clear();
+    for (const entry_range_t& block : cell.entries) {
+        for (size_t entry_id = block.begin; entry_id < block.begin + block.size; ++entry_id) {
+            worker.cell_signatures.insert({table_entries[entry_id].edge_order, &wide_edges_pool});
+        }
+    }
+
+    size_t cell_begin = worker.entries.size();
+    size_t cut_off_begin = worker.cut_off_candidates.size();
+    std::span<const edge_t> piercing_edges = range_edges(level_cell.piercing_edges);
     int num_vertices = static_cast<int>(boost::num_vertices(graph));
-    dp_table.resize(num_vertices);
-    for (int i = 0; i < num_vertices; ++i) {
-        dp_table[i].resize(num_vertices);
-        for (int j = i + 1; j < num_vertices; ++j) {
-            dp_table[i][j][0][""] = {};
+    for (int split_vertex = 0; split_vertex < num_vertices; ++split_vertex) {
+        if (!traits::contains(level_cell.right_side, split_vertex)) { continue; }
+        process_split(worker, level_cell.right_side, level_cell.right_size, piercing_edges, split_vertex,
+                      level_cell.new_cell);
+    }
+    for (size_t i = cell.cut_off_begin; !level_cell.new_cell && i < cell.cut_off_begin + cell.cut_off_size; ++i) {
+        const cut_off_candidate_t& candidate = previous_cut_off_candidates[i];
+        if (candidate.exceeded_count > crossing_number) {
+            worker.cut_off_candidates.push_back(candidate);
+            continue;
         }
+        process_candidate(worker, piercing_edges, candidate.split_vertex,
+                          candidate.part_a_edges, candidate.part_a_entry,
+                          candidate.part_b_edges, candidate.part_b_entry);
+    }
+    level_cell.entries = {cell_begin, worker.entries.size() - cell_begin};
+    level_cell.cut_off_candidates = {cut_off_begin, worker.cut_off_candidates.size() - cut_off_begin};
+}
+
+template <class vertex_set_t>
+bool basic_dp_solver<vertex_set_t>::is_drawable(thread_pool& pool) {
+    std::swap(previous_cut_off_candidates, cut_off_candidates);
+    cut_off_candidates.clear();
+    iteration_begin = table_entries.size();
+    int num_vertices = static_cast<int>(boost::num_vertices(graph));
+    workers.resize(pool.size());
+    for (worker_t& worker : workers) {
+        worker.triangle_edges.reserve(num_edges(graph));
+        worker.triangle_edges_map.assign(num_edges(graph), {{NONE, 0}, {NONE, 0}});
+        worker.edges_intersection_count.resize(num_edges(graph), 0);
     }
 
+    // Cells of one right side size only depend on cells of smaller sizes. All
+    // the cells of a level are created up front, so the workers only read the
+    // tables and write into their own buffers and the cell they process.
+    std::vector<level_cell_t> level_cells;
     for (int right_size = 1; right_size <= num_vertices - 2; ++right_size) {
+        level_cells.clear();
         for (int v_index = 0; v_index < num_vertices; ++v_index) {
-            active_link.first = v_index;
             for (int u_index = v_index + 1; u_index < num_vertices; ++u_index) {
-                active_link.second = u_index;
-                for (const auto& [right_side, piercing_edges] : dp_table_initialisation[v_index][u_index][right_size]) {
-                    for (int split_vertex = 0; split_vertex < num_vertices; ++split_vertex) {
-                        if ((right_side & 1 << split_vertex) == 0) { continue; }
-                        process_split(right_side, right_size, piercing_edges, split_vertex);
-                    }
-                    if (right_size == num_vertices - 2 && !dp_table[v_index][u_index][right_side].empty()) {
-                        return true;
-                    }
+                for (const auto& [right_side, piercing_range] : right_sides(v_index, u_index, right_size)) {
+                    auto [cell, new_cell] = dp_table[v_index][u_index].try_emplace(right_side);
+                    level_cells.push_back({v_index, u_index, right_side, right_size, piercing_range,
+                                           &cell->second, new_cell});
                 }
-                active_link.second = -1;
             }
-            active_link.first = -1;
+        }
+        for (worker_t& worker : workers) {
+            worker.entries.clear();
+            worker.wide_edges.clear();
+            worker.cut_off_candidates.clear();
+        }
+
+        bool last_level = right_size == num_vertices - 2;
+        std::atomic<bool> drawable = false;
+        pool.parallel_for(level_cells.size(), [&](size_t index, int worker) {
+            if (drawable.load(std::memory_order_relaxed)) { return; }
+            level_cell_t& level_cell = level_cells[index];
+            level_cell.worker = worker;
+            process_cell(workers[worker], level_cell);
+            if (last_level && level_cell.entries.size != 0) {
+                drawable.store(true, std::memory_order_relaxed);
+            }
+        });
+
+        // Moved in the order of the cells, so the tables do not depend on the scheduling
+        for (const level_cell_t& level_cell : level_cells) {
+            if (level_cell.worker < 0) { continue; }
+            const worker_t& worker = workers[level_cell.worker];
+            table_cell_t& cell = *level_cell.cell;
+            cell.cut_off_begin = cut_off_candidates.size();
+            cell.cut_off_size = level_cell.cut_off_candidates.size;
+            auto cut_off_begin = worker.cut_off_candidates.begin() + level_cell.cut_off_candidates.begin;
+            cut_off_candidates.insert(cut_off_candidates.end(), cut_off_begin, cut_off_begin + cell.cut_off_size);
+            if (level_cell.entries.size == 0) { continue; }
+            cell.entries.push_back({table_entries.size(), level_cell.entries.size});
+            auto entries_begin = worker.entries.begin() + level_cell.entries.begin;
+            table_entries.insert(table_entries.end(), entries_begin, entries_begin + level_cell.entries.size);
+            for (size_t i = table_entries.size() - level_cell.entries.size; i < table_entries.size(); ++i) {
+                edge_order_signature_t& signature = table_entries[i].edge_order;
+                if (signature.wide_size == 0) { continue; }
+                auto wide_edges = signature.wide_edges(worker.wide_edges);
+                signature.wide_begin = static_cast<uint32_t>(wide_edges_pool.size());
+                wide_edges_pool.insert(wide_edges_pool.end(), wide_edges.begin(), wide_edges.end());
+            }
+        }
+#ifndef NDEBUG
+        for (worker_t& worker : workers) {
+            hits += std::exchange(worker.hits, 0);
+            misses += std::exchange(worker.misses, 0);
+        }
+#endif
+        if (drawable) {
+            return true;
         }
     }
     return false;
 }
 
-void dp_solver::add_table_entries(int k) {
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::reset_table() {
+    dp_table.clear();
+    table_entries.clear();
+    wide_edges_pool.clear();
+    cut_off_candidates.clear();
+    // The only entry of every cell with an empty right side
+    table_entries.push_back({});
+    int num_vertices = static_cast<int>(boost::num_vertices(graph));
+    dp_table.resize(num_vertices);
+    for (int i = 0; i < num_vertices; ++i) {
+        dp_table[i].resize(num_vertices);
+        for (int j = i + 1; j < num_vertices; ++j) {
+            dp_table[i][j][vertex_set_t{}].entries.push_back({0, 1});
+        }
+    }
+}
+
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::add_table_entries(int k) {
     int num_vertices = static_cast<int>(boost::num_vertices(graph));
     for (int v_index = 0; v_index < num_vertices; ++v_index) {
         active_link.first = v_index;
@@ -339,22 +695,23 @@ void dp_solver::add_table_entries(int k) {
 }
 
 
-void dp_solver::initialise_table() {
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::initialise_table() {
     dp_table_initialisation.clear();
+    piercing_edges_pool.clear();
     int num_vertices = static_cast<int>(boost::num_vertices(graph));
     dp_table_initialisation.resize(num_vertices);
     for (int v_index = 0; v_index < num_vertices; ++v_index) {
         dp_table_initialisation[v_index].resize(num_vertices);
-        for (int u_index = 0; u_index < num_vertices; ++u_index) {
-            dp_table_initialisation[v_index][u_index].resize(num_vertices - 1);
-        }
     }
     for (int k = 0; k <= crossing_number; add_table_entries(k++)) {}
+    reset_table();
 }
 
-void dp_solver::select_edges(filtered_graph_t::edge_iterator start,
-                             const filtered_graph_t::edge_iterator& end,
-                             int k) {
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::select_edges(filtered_graph_t::edge_iterator start,
+                                                 const filtered_graph_t::edge_iterator& end,
+                                                 int k) {
     if (k == 0) {
         fill_right_sides();
         return;
@@ -366,7 +723,8 @@ void dp_solver::select_edges(filtered_graph_t::edge_iterator start,
     }
 }
 
-void dp_solver::fill_right_sides() {
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::fill_right_sides() {
     std::vector<int> component_map(num_vertices(graph));
     int num_components = connected_components(
         filtered_graph,
@@ -392,30 +750,35 @@ void dp_solver::fill_right_sides() {
                       make_iterator_property_map(component_colors.begin(), component_index_map))) {
         return;
     }
-    std::vector<std::pair<std::pair<size_t, int>, std::pair<size_t, int>>> sides(num_clusters);
+    std::vector<cluster_sides_t> sides(num_clusters);
     for (auto [vi, vi_end] = vertices(filtered_graph); vi != vi_end; ++vi) {
         int v_index = static_cast<int>(get(vertex_index_map, *vi));
         int component_index = component_map[v_index];
         int cluster_index = cluster_map[component_index];
         boost::default_color_type component_color = component_colors[component_index];
         if (component_color == boost::default_color_type::white_color) {
-            sides[cluster_index].first.first |= 1 << v_index;
+            sides[cluster_index].first.first |= traits::singleton(v_index);
             ++sides[cluster_index].first.second;
         } else {
-            sides[cluster_index].second.first |= 1 << v_index;
+            sides[cluster_index].second.first |= traits::singleton(v_index);
             ++sides[cluster_index].second.second;
         }
     }
 
-    populate_right_sides(sides.begin(), sides.end(), 0, 0);
+    populate_right_sides(sides.begin(), sides.end(), vertex_set_t{}, 0);
 }
 
-void dp_solver::populate_right_sides(
-    std::vector<std::pair<std::pair<size_t, int>, std::pair<size_t, int>>>::iterator start,
-    std::vector<std::pair<std::pair<size_t, int>, std::pair<size_t, int>>>::iterator end,
-    size_t cur_side, int count) {
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::populate_right_sides(
+    typename std::vector<cluster_sides_t>::iterator start,
+    typename std::vector<cluster_sides_t>::iterator end,
+    vertex_set_t cur_side, int count) {
     if (start == end) {
-        dp_table_initialisation[active_link.first][active_link.second][count][cur_side] = filtered_edges;
+        size_t begin = piercing_edges_pool.size();
+        piercing_edges_pool.insert(piercing_edges_pool.end(), filtered_edges.begin(), filtered_edges.end());
+        auto& link_sides = dp_table_initialisation[active_link.first][active_link.second];
+        if (static_cast<int>(link_sides.size()) <= count) { link_sides.resize(count + 1); }
+        link_sides[count][cur_side] = {begin, filtered_edges.size()};
         return;
     }
     auto [r, l] = *start;
@@ -425,39 +788,80 @@ void dp_solver::populate_right_sides(
 }
 
 #ifndef NDEBUG
-void dp_solver::print_table() {
+template <class vertex_set_t>
+void basic_dp_solver<vertex_set_t>::print_table() {
     for (int i = 0; i < static_cast<int>(dp_table.size()); ++i) {
         for (int j = 0; j < static_cast<int>(dp_table[i].size()); ++j) {
-            std::cout << "Active link: " << i << "-" << j << std::endl;
-            std::vector<size_t> entries;
-            for (const auto& key : dp_table[i][j] | std::views::keys) {
-                entries.emplace_back(key);
+            std::cerr << "Active link: " << i << "-" << j << std::endl;
+            std::vector<vertex_set_t> entries;
+            for (const auto& [key, cell] : dp_table[i][j]) {
+                if (!cell.entries.empty()) { entries.emplace_back(key); }
             }
             std::ranges::sort(entries);
             for (auto side : entries) {
-                int size = 0;
-                for (int k = 0; 1UL << k <= side; size += (1 << k++ & side) != 0) {}
-                auto edges = std::ranges::find_if(dp_table_initialisation[i][j][size],
-                                                  [side](const std::pair<size_t, std::vector<edge_t>>& pair) {
-                                                      return pair.first == side;
-                                                  })->second;
-                std::cout << std::bitset<10>(side) << ": {";
-                for (const table_entry_t& entry : dp_table[i][j][side] | std::views::values) {
-                    std::cout << "[(";
-                    for (auto [edge_id, cross] : entry.edge_order) {
-                        std::cout << std::to_string(edges[edge_id].m_source) + std::to_string(
+                int size = traits::size(side);
+                std::span<const edge_t> edges = range_edges(dp_table_initialisation[i][j][size].at(side));
+                for (int v = static_cast<int>(dp_table.size()); v-- > 0;) {
+                    std::cerr << traits::contains(side, v);
+                }
+                std::cerr << ": {";
+                std::vector<size_t> entry_ids;
+                for (const entry_range_t& block : dp_table[i][j][side].entries) {
+                    for (size_t entry_id = block.begin; entry_id < block.begin + block.size; ++entry_id) {
+                        entry_ids.push_back(entry_id);
+                    }
+                }
+                for (size_t entry_id : entry_ids) {
+                    const table_entry_t& entry = table_entries[entry_id];
+                    std::cerr << "[(";
+                    for (int position = 0; position < static_cast<int>(edges.size()); ++position) {
+                        auto [edge_id, cross] = entry.edge_order.get(position, wide_edges_pool);
+                        std::cerr << std::to_string(edges[edge_id].m_source) + std::to_string(
                             edges[edge_id].m_target) + " " + std::to_string(cross) << ",";
                     }
-                    std::cout << "), ";
-                    for (auto v : entry.vertex_order) {
-                        std::cout << v;
+                    std::cerr << "), ";
+                    std::vector<vertex_t> entry_order;
+                    restore_vertex_order(entry_order, {i, j}, entry_id, false);
+                    for (auto v : entry_order) {
+                        std::cerr << v;
                     }
-                    std::cout << "],";
+                    std::cerr << "],";
                 }
-                std::cout << "}" << std::endl;
+                std::cerr << "}" << std::endl;
             }
-            std::cout << std::endl;
+            std::cerr << std::endl;
         }
     }
 }
 #endif
+
+template class basic_dp_solver<uint64_t>;
+template class basic_dp_solver<unsigned __int128>;
+template class basic_dp_solver<wide_vertex_set<4>>;
+
+bool dp_solver::solve() {
+    int num_vertices = static_cast<int>(boost::num_vertices(graph));
+    if (num_vertices <= vertex_set_traits<uint64_t>::capacity) {
+        return solve_with<uint64_t>();
+    }
+    if (num_vertices <= vertex_set_traits<unsigned __int128>::capacity) {
+        return solve_with<unsigned __int128>();
+    }
+    if (num_vertices <= max_vertices) {
+        return solve_with<wide_vertex_set<4>>();
+    }
+#ifndef PERF_TEST
+    std::cerr << "ERROR: The input graph is too big for dp_solver." << std::endl;
+#endif
+    return false;
+}
+
+template <class vertex_set_t>
+bool dp_solver::solve_with() {
+    basic_dp_solver<vertex_set_t> solver(graph, crossing_number, options);
+    bool ok = solver.solve();
+    crossing_number = solver.crossing_number;
+    oracle_calls = solver.oracle_calls;
+    vertex_order = std::move(solver.vertex_order);
+    return ok;
+}
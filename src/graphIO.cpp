@@ -1,3 +1,6 @@
+#include <cctype>
+#include <stdexcept>
+#include "crossing_count.h"
 #include "graphIO.h"
 
 void save_dot(const std::string& file_name, graph_t& graph,
@@ -13,9 +16,16 @@ void save_dot(const std::string& file_name, graph_t& graph,
         graph[ordering[j]].location = std::to_string(x) + ','
                                       + std::to_string(y) + '!';
     }
+    std::vector<chord_t> chords;
+    for (edge_t e : make_iterator_range(edges(graph))) {
+        chords.emplace_back(graph[source(e, graph)].order, graph[target(e, graph)].order);
+    }
+    std::vector<int> crossings(chords.size());
+    crossing_counter().count(chords, crossings);
+    int edge_id = 0;
     for (edge_t e : make_iterator_range(edges(graph))) {
         graph[e].color = "";
-        int crossing = count_edge_crossing(e, graph);
+        int crossing = crossings[edge_id++];
         if (crossing == number_of_crossings) {
             graph[e].color = "blue";
         } else if (crossing > number_of_crossings) {
@@ -28,18 +38,110 @@ void save_dot(const std::string& file_name, graph_t& graph,
 }
 
 int count_edge_crossing(const edge_t& edge, const graph_t& graph) {
+    chord_t chord(graph[source(edge, graph)].order, graph[target(edge, graph)].order);
     int result = 0;
-    int edge_src = graph[source(edge, graph)].order;
-    int edge_trg = graph[target(edge, graph)].order;
-    if (edge_src > edge_trg) { std::swap(edge_src, edge_trg); }
     for (edge_t other : make_iterator_range(edges(graph))) {
-        int other_src = graph[source(other, graph)].order;
-        int other_trg = graph[target(other, graph)].order;
-        if (other_src > other_trg) { std::swap(other_src, other_trg); }
-        bool src_between = edge_src < other_src && other_src < edge_trg;
-        bool trg_between = edge_src < other_trg && other_trg < edge_trg;
-        result += (src_between && other_trg > edge_trg) ||
-            (trg_between && other_src < edge_src);
+        result += chords_cross(chord, {graph[source(other, graph)].order, graph[target(other, graph)].order});
     }
     return result;
 }
+
+namespace {
+    // Graphviz records start with an optional `strict` and the `graph` or `digraph`
+    // keyword, the body may follow the keyword without whitespace
+    bool is_graphviz_keyword(const std::string& word) {
+        return word == "strict" || word == "graph" || word == "digraph";
+    }
+
+    std::string first_word(const std::string& record) {
+        size_t begin = record.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) { return ""; }
+        size_t end = record.find_first_of(" \t\r\n{", begin);
+        return record.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+    }
+}
+
+bool read_graph_record(std::istream& in, std::string& record) {
+    while (in >> std::ws && in.peek() != std::istream::traits_type::eof()) {
+        record.clear();
+        while (in.peek() != std::istream::traits_type::eof() && !std::isspace(in.peek()) && in.peek() != '{') {
+            record.push_back(static_cast<char>(in.get()));
+        }
+        if (is_graphviz_keyword(record)) {
+            int depth = 0;
+            for (char c; in.get(c);) {
+                record.push_back(c);
+                if (c == '{') {
+                    ++depth;
+                } else if (c == '}' && --depth == 0) {
+                    return true;
+                }
+            }
+            return true;
+        }
+        // '{' is a valid graph6 character, so a graph6 string runs up to the next whitespace
+        while (in.peek() != std::istream::traits_type::eof() && !std::isspace(in.peek())) {
+            record.push_back(static_cast<char>(in.get()));
+        }
+        if (record.starts_with(">>graph6<<")) { record.erase(0, 10); }
+        if (record.empty()) { continue; }
+        return true;
+    }
+    return false;
+}
+
+void parse_graph_record(const std::string& record, graph_t& graph,
+                        boost::dynamic_properties& graph_props) {
+    if (is_graphviz_keyword(first_word(record))) {
+        read_graphviz(record, graph, graph_props);
+    } else {
+        read_graph6(record, graph);
+    }
+}
+
+void read_graph6(const std::string& graph6, graph_t& graph) {
+    auto byte = [&graph6](size_t position) {
+        if (position >= graph6.size() || graph6[position] < 63 || graph6[position] > 126) {
+            throw std::runtime_error("Malformed graph6 string: " + graph6);
+        }
+        return static_cast<size_t>(graph6[position] - 63);
+    };
+
+    size_t position = 0;
+    size_t num_vertices = byte(position++);
+    if (num_vertices == 63) {
+        int size_bytes = 3;
+        if (byte(position) == 63) {
+            size_bytes = 6;
+            ++position;
+        }
+        num_vertices = 0;
+        for (int i = 0; i < size_bytes; ++i) {
+            num_vertices = num_vertices << 6 | byte(position++);
+        }
+    }
+
+    // Checked before adding any vertex, as a malformed header can claim up to 2^36 of them
+    unsigned __int128 adjacency_bits = static_cast<unsigned __int128>(num_vertices) * (num_vertices - 1) / 2;
+    if ((adjacency_bits + 5) / 6 != graph6.size() - position) {
+        throw std::runtime_error("Malformed graph6 string: " + graph6);
+    }
+
+    for (size_t v = 0; v < num_vertices; ++v) {
+        vertex_t vertex = add_vertex(graph);
+        graph[vertex].name = std::to_string(v);
+    }
+
+    int bit = 5;
+    for (size_t j = 1; j < num_vertices; ++j) {
+        for (size_t i = 0; i < j; ++i) {
+            if (byte(position) >> bit & 1) {
+                add_edge(i, j, graph);
+            }
+            if (--bit < 0) {
+                bit = 5;
+                ++position;
+            }
+        }
+    }
+}
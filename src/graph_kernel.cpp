@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <list>
+#include <ranges>
+#include "graph_kernel.h"
+
+graph_kernel_t::graph_kernel_t(const graph_t& graph) : num_input_vertices(static_cast<int>(num_vertices(graph))) {
+    std::vector<std::vector<vertex_t>> neighbours(num_input_vertices);
+    for (edge_t edge : boost::make_iterator_range(edges(graph))) {
+        neighbours[source(edge, graph)].push_back(target(edge, graph));
+        neighbours[target(edge, graph)].push_back(source(edge, graph));
+    }
+    std::vector<int> degree(num_input_vertices);
+    std::ranges::transform(neighbours, degree.begin(), [](const auto& list) { return static_cast<int>(list.size()); });
+    std::vector<bool> alive(num_input_vertices, true);
+    int num_alive = num_input_vertices;
+
+    // Pendant vertices, a tree keeps its last vertex
+    std::vector<vertex_t> stack;
+    for (vertex_t v = 0; v < static_cast<vertex_t>(num_input_vertices); ++v) {
+        if (degree[v] == 1) { stack.push_back(v); }
+    }
+    while (!stack.empty()) {
+        vertex_t v = stack.back();
+        stack.pop_back();
+        if (!alive[v] || degree[v] != 1) { continue; }
+        vertex_t neighbour = *std::ranges::find_if(neighbours[v], [&alive](vertex_t u) { return alive[u]; });
+        alive[v] = false;
+        --num_alive;
+        degree[v] = 0;
+        pendants.push_back({v, neighbour});
+        if (--degree[neighbour] == 1) { stack.push_back(neighbour); }
+    }
+
+    // A chain vertex has two distinct neighbours, parallel edges and self-loops end a chain
+    auto is_chain_vertex = [&](vertex_t v) {
+        if (!alive[v] || degree[v] != 2) { return false; }
+        std::vector<vertex_t> alive_neighbours;
+        std::ranges::copy_if(neighbours[v], std::back_inserter(alive_neighbours),
+                             [&alive](vertex_t u) { return alive[u]; });
+        return alive_neighbours.size() == 2 && alive_neighbours[0] != alive_neighbours[1] &&
+            alive_neighbours[0] != v && alive_neighbours[1] != v;
+    };
+
+    // Chains of degree-2 vertices from a vertex of another kind, or around a cycle if there is none
+    std::vector<vertex_t> ends;
+    for (vertex_t v = 0; v < static_cast<vertex_t>(num_input_vertices); ++v) {
+        if (alive[v] && !is_chain_vertex(v)) { ends.push_back(v); }
+    }
+    if (ends.empty() && num_alive > 3) {
+        ends.push_back(static_cast<vertex_t>(std::ranges::find(alive, true) - alive.begin()));
+    }
+    std::vector<bool> in_chain(num_input_vertices, false);
+    std::vector<std::pair<vertex_t, vertex_t>> shortcuts;
+    for (vertex_t start : ends) {
+        for (vertex_t first : neighbours[start]) {
+            if (in_chain[first] || first == start || !is_chain_vertex(first)) { continue; }
+            std::vector<vertex_t> chain;
+            vertex_t previous = start;
+            vertex_t current = first;
+            while (current != start && is_chain_vertex(current)) {
+                in_chain[current] = true;
+                chain.push_back(current);
+                vertex_t next = *std::ranges::find_if(neighbours[current], [&](vertex_t u) {
+                    return alive[u] && u != previous;
+                });
+                previous = std::exchange(current, next);
+            }
+            vertex_t end = current;
+
+            // Vertices outside the chain, at least one chain vertex is kept and two on a cycle
+            int kept = std::max(num_alive - static_cast<int>(chain.size()), end == start ? 2 : 1);
+            if (static_cast<int>(chain.size()) <= kept) { continue; }
+            chain_t shortened{chain[kept - 1], kept >= 2 ? chain[kept - 2] : start, end,
+                              {chain.begin() + kept, chain.end()}};
+            for (vertex_t v : shortened.removed) { alive[v] = false; }
+            num_alive -= static_cast<int>(shortened.removed.size());
+            shortcuts.emplace_back(shortened.last_kept, end);
+            chains.push_back(std::move(shortened));
+        }
+    }
+
+    std::vector<int> local_index(num_input_vertices, -1);
+    std::vector<vertex_t> global_vertices;
+    for (vertex_t v = 0; v < static_cast<vertex_t>(num_input_vertices); ++v) {
+        if (!alive[v]) { continue; }
+        local_index[v] = static_cast<int>(global_vertices.size());
+        global_vertices.push_back(v);
+    }
+    std::vector<std::pair<int, int>> kernel_edges;
+    for (edge_t edge : boost::make_iterator_range(edges(graph))) {
+        vertex_t u = source(edge, graph);
+        vertex_t v = target(edge, graph);
+        if (alive[u] && alive[v]) { kernel_edges.emplace_back(local_index[u], local_index[v]); }
+    }
+    for (auto [u, v] : shortcuts) { kernel_edges.emplace_back(local_index[u], local_index[v]); }
+    kernel = graph_view_t(std::move(global_vertices), std::move(kernel_edges));
+}
+
+std::vector<vertex_t> graph_kernel_t::lift(const std::vector<vertex_t>& kernel_order) const {
+    std::list<vertex_t> order;
+    std::vector<std::list<vertex_t>::iterator> positions(num_input_vertices, order.end());
+    for (vertex_t v : kernel_order) { positions[v] = order.insert(order.end(), v); }
+
+    for (const chain_t& chain : chains | std::views::reverse) {
+        // The removed vertices go next to v_T on the side of the edge v_{T-1} v_T where w lies
+        auto current = positions[chain.last_kept];
+        do {
+            if (++current == order.end()) { current = order.begin(); }
+        } while (*current != chain.end && *current != chain.before_last_kept);
+
+        if (*current == chain.end) {
+            auto insert_iter = std::next(positions[chain.last_kept]);
+            for (vertex_t v : chain.removed) { positions[v] = order.insert(insert_iter, v); }
+        } else {
+            auto insert_iter = positions[chain.last_kept];
+            for (vertex_t v : chain.removed) { insert_iter = positions[v] = order.insert(insert_iter, v); }
+        }
+    }
+    for (const pendant_t& pendant : pendants | std::views::reverse) {
+        positions[pendant.vertex] = order.insert(std::next(positions[pendant.neighbour]), pendant.vertex);
+    }
+    return {order.begin(), order.end()};
+}
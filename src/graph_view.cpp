@@ -0,0 +1,24 @@
+#include "graph_view.h"
+
+graph_view_t::graph_view_t(std::vector<vertex_t> global_vertices, std::vector<std::pair<int, int>> edges)
+    : global_vertices(std::move(global_vertices)), edges(std::move(edges)),
+      offsets(this->global_vertices.size() + 1, 0), targets(2 * this->edges.size()) {
+    for (auto [u, v] : this->edges) {
+        ++offsets[u + 1];
+        ++offsets[v + 1];
+    }
+    for (size_t v = 0; v < this->global_vertices.size(); ++v) { offsets[v + 1] += offsets[v]; }
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (auto [u, v] : this->edges) {
+        targets[next[u]++] = v;
+        targets[next[v]++] = u;
+    }
+}
+
+graph_t graph_view_t::to_graph() const {
+    graph_t graph(global_vertices.size());
+    for (int i = 0; i < num_edges(); ++i) {
+        add_edge(edges[i].first, edges[i].second, i, graph);
+    }
+    return graph;
+}
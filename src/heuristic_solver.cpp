@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <numbers>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include "crossing_count.h"
+#include "crossing_search.h"
+#include "heuristic_solver.h"
+#include "lower_bound.h"
+
+namespace {
+    // The graph with vertices and edges given by their indices
+    struct indexed_graph_t {
+        std::vector<std::pair<int, int>> edges;
+        std::vector<std::vector<int>> neighbours;
+        std::vector<std::vector<int>> incident_edges;
+    };
+
+    indexed_graph_t index_graph(const graph_t& graph) {
+        indexed_graph_t indexed;
+        indexed.neighbours.resize(num_vertices(graph));
+        indexed.incident_edges.resize(num_vertices(graph));
+        for (edge_t edge : make_iterator_range(edges(graph))) {
+            int u = static_cast<int>(get(boost::vertex_index, graph, source(edge, graph)));
+            int v = static_cast<int>(get(boost::vertex_index, graph, target(edge, graph)));
+            int edge_index = static_cast<int>(indexed.edges.size());
+            indexed.edges.emplace_back(u, v);
+            indexed.neighbours[u].push_back(v);
+            indexed.neighbours[v].push_back(u);
+            indexed.incident_edges[u].push_back(edge_index);
+            indexed.incident_edges[v].push_back(edge_index);
+        }
+        return indexed;
+    }
+
+    // Vertices in the order a breadth or depth first search from root discovers them
+    std::vector<int> search_order(const indexed_graph_t& graph, int root, bool depth_first) {
+        int num_vertices = static_cast<int>(graph.neighbours.size());
+        std::vector<int> order;
+        std::vector<bool> discovered(num_vertices, false);
+        std::deque<int> pending;
+        for (int start = 0; start < num_vertices; ++start) {
+            int first = (root + start) % num_vertices;
+            if (discovered[first]) { continue; }
+            pending.push_back(first);
+            while (!pending.empty()) {
+                int v;
+                if (depth_first) {
+                    v = pending.back();
+                    pending.pop_back();
+                } else {
+                    v = pending.front();
+                    pending.pop_front();
+                }
+                if (discovered[v]) { continue; }
+                discovered[v] = true;
+                order.push_back(v);
+                for (int u : graph.neighbours[v] | std::views::reverse) {
+                    if (!discovered[u]) { pending.push_back(u); }
+                }
+            }
+        }
+        return order;
+    }
+
+    // Reorders the vertices by the circular mean of their own and their neighbours' angles
+    std::vector<int> barycentric_order(const indexed_graph_t& graph, const std::vector<int>& order) {
+        int num_vertices = static_cast<int>(order.size());
+        std::vector<double> angles(num_vertices);
+        for (int i = 0; i < num_vertices; ++i) {
+            angles[order[i]] = 2 * std::numbers::pi * i / num_vertices;
+        }
+        std::vector<double> targets(num_vertices);
+        for (int v = 0; v < num_vertices; ++v) {
+            double x = std::cos(angles[v]);
+            double y = std::sin(angles[v]);
+            for (int u : graph.neighbours[v]) {
+                x += std::cos(angles[u]);
+                y += std::sin(angles[u]);
+            }
+            targets[v] = std::atan2(y, x);
+        }
+        std::vector<int> result = order;
+        std::ranges::stable_sort(result, {}, [&targets](int v) { return targets[v]; });
+        return result;
+    }
+
+    class order_evaluator {
+    public:
+        explicit order_evaluator(const indexed_graph_t& graph)
+            : graph(graph), positions(graph.neighbours.size()), chords(graph.edges.size()),
+              crossings(graph.edges.size()) {}
+
+        int local_crossing_number(const std::vector<int>& order) {
+            for (int i = 0; i < static_cast<int>(order.size()); ++i) { positions[order[i]] = i; }
+            for (size_t i = 0; i < graph.edges.size(); ++i) {
+                chords[i] = {positions[graph.edges[i].first], positions[graph.edges[i].second]};
+            }
+            counter.count(chords, crossings);
+            return crossings.empty() ? 0 : *std::ranges::max_element(crossings);
+        }
+
+    private:
+        const indexed_graph_t& graph;
+        crossing_counter counter;
+        std::vector<int> positions;
+        std::vector<chord_t> chords;
+        std::vector<int> crossings;
+    };
+
+    /*
+     * A circular order together with the crossings of every edge. Swapping two
+     * vertices only recounts the crossings of their incident edges, in
+     * O((deg u + deg v) m). The cost orders drawings by their local crossing
+     * number first and by the sum of the squared crossings of the edges next.
+     */
+    class annealing_state {
+    public:
+        annealing_state(const indexed_graph_t& graph, const std::vector<int>& order)
+            : graph(graph), vertex_at(order), positions(order.size()), crossings(graph.edges.size()),
+              histogram(graph.edges.size() + 1), stamps(graph.edges.size(), 0) {
+            long long num_edges = static_cast<long long>(graph.edges.size());
+            maximum_weight = num_edges * num_edges * num_edges + 1;
+            for (int i = 0; i < static_cast<int>(order.size()); ++i) { positions[order[i]] = i; }
+            std::vector<chord_t> chords;
+            for (auto [u, v] : graph.edges) { chords.emplace_back(positions[u], positions[v]); }
+            crossing_counter().count(chords, crossings);
+            for (int count : crossings) {
+                ++histogram[count];
+                square_sum += static_cast<long long>(count) * count;
+                maximum = std::max(maximum, count);
+            }
+        }
+
+        // Exchanges the vertices at two positions
+        void swap(int first, int second) {
+            int u = vertex_at[first];
+            int v = vertex_at[second];
+            recount(u, v, -1);
+            std::swap(vertex_at[first], vertex_at[second]);
+            std::swap(positions[u], positions[v]);
+            recount(u, v, 1);
+            while (maximum > 0 && histogram[maximum] == 0) { --maximum; }
+        }
+
+        long long cost() const { return maximum * maximum_weight + square_sum; }
+        long long mean_square_crossings() const {
+            return graph.edges.empty() ? 0 : square_sum / static_cast<long long>(graph.edges.size());
+        }
+        int local_crossing_number() const { return maximum; }
+        const std::vector<int>& order() const { return vertex_at; }
+
+    private:
+        // Adds change for every crossing of an edge incident to u or v
+        void recount(int u, int v, int change) {
+            ++stamp;
+            affected.clear();
+            for (int vertex : {u, v}) {
+                for (int edge : graph.incident_edges[vertex]) {
+                    if (stamps[edge] != stamp) {
+                        stamps[edge] = stamp;
+                        affected.push_back(edge);
+                    }
+                }
+            }
+            int num_edges = static_cast<int>(graph.edges.size());
+            for (int edge : affected) {
+                chord_t chord = edge_chord(edge);
+                for (int other = 0; other < num_edges; ++other) {
+                    // Pairs of affected edges are counted from their larger index only
+                    if (other == edge || (stamps[other] == stamp && other > edge)) { continue; }
+                    if (chords_cross(chord, edge_chord(other))) {
+                        add(edge, change);
+                        add(other, change);
+                    }
+                }
+            }
+        }
+
+        void add(int edge, int change) {
+            int& count = crossings[edge];
+            --histogram[count];
+            square_sum -= static_cast<long long>(count) * count;
+            count += change;
+            ++histogram[count];
+            square_sum += static_cast<long long>(count) * count;
+            maximum = std::max(maximum, count);
+        }
+
+        chord_t edge_chord(int edge) const {
+            return {positions[graph.edges[edge].first], positions[graph.edges[edge].second]};
+        }
+
+        const indexed_graph_t& graph;
+        std::vector<int> vertex_at;
+        std::vector<int> positions;
+        std::vector<int> crossings;
+        // Number of edges with every number of crossings
+        std::vector<int> histogram;
+        int maximum = 0;
+        long long square_sum = 0;
+        // Larger than any square sum, so the maximum dominates the cost
+        long long maximum_weight;
+        std::vector<int> affected;
+        std::vector<int> stamps;
+        int stamp = 0;
+    };
+}
+
+int heuristic_drawing(const graph_t& graph, const solver_options_t& options, std::vector<vertex_t>& order) {
+    int num_vertices = static_cast<int>(boost::num_vertices(graph));
+    order.clear();
+    order.insert(order.end(), vertices(graph).first, vertices(graph).second);
+    if (num_vertices <= 3) { return 0; }
+
+    indexed_graph_t indexed = index_graph(graph);
+    order_evaluator evaluator(indexed);
+    int lower_bound = local_crossing_lower_bound(graph);
+
+    int root = static_cast<int>(std::ranges::max_element(indexed.neighbours, {}, &std::vector<int>::size) -
+        indexed.neighbours.begin());
+    std::vector<int> identity(num_vertices);
+    std::iota(identity.begin(), identity.end(), 0);
+
+    std::vector<int> best_order;
+    int best = -1;
+    for (const std::vector<int>& start : {identity, search_order(indexed, root, false),
+                                          search_order(indexed, root, true)}) {
+        std::vector<int> candidate = start;
+        for (int round = 0; round < 8 && best != lower_bound; ++round) {
+            int crossings = evaluator.local_crossing_number(candidate);
+            if (best < 0 || crossings < best) {
+                best = crossings;
+                best_order = candidate;
+            }
+            std::vector<int> next = barycentric_order(indexed, candidate);
+            if (next == candidate) { break; }
+            candidate = std::move(next);
+        }
+    }
+
+    if (best != lower_bound && options.heuristic_moves > 0) {
+        annealing_state state(indexed, best_order);
+        long long best_cost = state.cost();
+        long long moves = static_cast<long long>(options.heuristic_moves) * num_vertices;
+        // The temperature falls geometrically from the mean squared crossings of an edge to almost nothing
+        double temperature = 1.0 + static_cast<double>(state.mean_square_crossings());
+        double cooling = std::pow(0.01 / temperature, 1.0 / static_cast<double>(moves));
+        std::mt19937 random;
+        std::uniform_int_distribution<int> first_position(0, num_vertices - 1);
+        std::uniform_int_distribution<int> second_position(0, num_vertices - 2);
+        std::uniform_real_distribution<double> acceptance(0.0, 1.0);
+        for (long long move = 0; move < moves && best != lower_bound; ++move, temperature *= cooling) {
+            int first = first_position(random);
+            int second = second_position(random);
+            if (second >= first) { ++second; }
+            long long cost = state.cost();
+            state.swap(first, second);
+            long long increase = state.cost() - cost;
+            if (increase > 0 && acceptance(random) >= std::exp(-static_cast<double>(increase) / temperature)) {
+                state.swap(first, second);
+            } else if (state.cost() < best_cost) {
+                best_cost = state.cost();
+                best = state.local_crossing_number();
+                best_order = state.order();
+            }
+        }
+    }
+
+    std::ranges::transform(best_order, order.begin(), [&graph](int v) { return vertex(v, graph); });
+    return best;
+}
+
+bool heuristic_solver::solve() {
+    crossing_number = heuristic_drawing(graph, options, vertex_order);
+    return true;
+}
@@ -1,20 +1,144 @@
 #include <iostream>
+#include <memory>
 #include <vector>
 #include <algorithm>
 #include <gurobi_c++.h>
+#include "crossable_pairs.h"
+#include "crossing_count.h"
+#include "crossing_patterns.h"
+#include "heuristic_solver.h"
 #include "ilp_solver.h"
+#include "lower_bound.h"
+#include "timer.h"
+
+/*
+ * Checks every new incumbent and every optimal node relaxation against the
+ * constraints left out of the model and adds the violated ones as lazy
+ * constraints: the transitivity constraints with --ilp-transitivity lazy,
+ * the crossing constraints with --ilp-crossings lazy.
+ */
+class ilp_solver::lazy_constraint_callback : public GRBCallback {
+public:
+    explicit lazy_constraint_callback(const ilp_solver& solver)
+        : solver(solver), num_vertices(static_cast<int>(solver.order_variables.size())),
+          variables(solver.before_variables) {
+        for (const crossing_pair_t& pair : solver.crossing_pairs) { variables.push_back(pair.do_cross); }
+    }
+
+    int added_constraints = 0;
+
+protected:
+    void callback() override {
+        std::unique_ptr<double[]> values;
+        if (where == GRB_CB_MIPSOL) {
+            values.reset(getSolution(variables.data(), static_cast<int>(variables.size())));
+        } else if (where == GRB_CB_MIPNODE && getIntInfo(GRB_CB_MIPNODE_STATUS) == GRB_OPTIMAL) {
+            values.reset(getNodeRel(variables.data(), static_cast<int>(variables.size())));
+        } else {
+            return;
+        }
+        auto before = [&](int i, int j) {
+            return i < j ? values[pair_index(i, j)] : 1 - values[pair_index(j, i)];
+        };
+
+        if (solver.options.ilp_transitivity == LAZY_TRANSITIVITY) {
+            for (int first = 0; first < num_vertices; ++first) {
+                for (int second = first + 1; second < num_vertices; ++second) {
+                    for (int third = second + 1; third < num_vertices; ++third) {
+                        for (auto [a, b, c] : {std::array{first, second, third}, std::array{first, third, second}}) {
+                            if (before(a, b) + before(b, c) + before(c, a) <= 2 + tolerance) { continue; }
+                            const auto& order = solver.order_variables;
+                            addLazy(order[a][b] + order[b][c] + order[c][a] <= 2);
+                            ++added_constraints;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (solver.options.ilp_crossings == LAZY_CROSSINGS) {
+            const double* do_cross = values.get() + solver.before_variables.size();
+            if (solver.options.exact_crossings) {
+                add_crossing_constraints<true>(before, do_cross);
+            } else {
+                add_crossing_constraints<false>(before, do_cross);
+            }
+        }
+    }
+
+private:
+    static constexpr double tolerance = 1e-6;
+
+    // The crossing constraints violated by the values, specialised for options.exact_crossings
+    template <bool exact, class before_t>
+    void add_crossing_constraints(const before_t& before, const double* do_cross) {
+        for (size_t index = 0; index < solver.crossing_pairs.size(); ++index) {
+            const crossing_pair_t& pair = solver.crossing_pairs[index];
+            auto path = [&](const std::array<int, 4>& pattern) {
+                return before(pair.ends[pattern[0]], pair.ends[pattern[1]]) +
+                    before(pair.ends[pattern[1]], pair.ends[pattern[2]]) +
+                    before(pair.ends[pattern[2]], pair.ends[pattern[3]]);
+            };
+            for (const std::array<int, 4>& pattern : crossing_patterns) {
+                if (path(pattern) - 2 <= do_cross[index] + tolerance) { continue; }
+                addLazy(solver.crossing_constraint(pair, pattern));
+                ++added_constraints;
+            }
+            if constexpr (exact) {
+                for (const std::array<int, 4>& pattern : non_crossing_patterns) {
+                    if (do_cross[index] <= 3 - path(pattern) + tolerance) { continue; }
+                    addLazy(solver.non_crossing_constraint(pair, pattern));
+                    ++added_constraints;
+                }
+            }
+        }
+    }
+
+    // Position of "i before j" in before_variables for i < j
+    int pair_index(int i, int j) const { return i * num_vertices - i * (i + 1) / 2 + j - i - 1; }
+
+    const ilp_solver& solver;
+    const int num_vertices;
+    // The order variables followed by the crossing variables
+    std::vector<GRBVar> variables;
+};
 
 bool ilp_solver::solve() {
-    vertex_order.clear();
-    vertex_order.insert(vertex_order.end(), vertices(graph).first, vertices(graph).second);
+    // The heuristic drawing is the MIP start
+    int start_crossing_number = heuristic_drawing(graph, options, vertex_order);
     if (vertex_order.size() <= 3) {
         crossing_number = 0;
         return true;
     }
+    // The MIP start has to fulfil the symmetry breaking constraints
+    if (options.symmetry_breaking) {
+        symmetries = find_order_symmetries(graph);
+        symmetries.canonicalise(vertex_order, graph);
+    }
+    start_positions.assign(vertex_order.size(), 0);
+    for (int i = 0; i < static_cast<int>(vertex_order.size()); ++i) {
+        start_positions[get(vertex_index_map, vertex_order[i])] = i;
+    }
 
+    auto build_start = get_current_time_fenced();
     GRBModel model = GRBModel(*gurobi_env);
-    initialise_model(model);
+    model.set(GRB_IntParam_Threads, options.threads);
+    initialise_model(model, start_crossing_number);
+    lazy_constraint_callback callback(*this);
+    if (options.ilp_transitivity == LAZY_TRANSITIVITY || options.ilp_crossings == LAZY_CROSSINGS) {
+        model.set(GRB_IntParam_LazyConstraints, 1);
+        model.setCallback(&callback);
+    }
+    model.update();
+    auto solve_start = get_current_time_fenced();
     model.optimize();
+#ifndef PERF_TEST
+    std::cerr << "ILP model: " << model.get(GRB_IntAttr_NumVars) << " variables, "
+        << model.get(GRB_IntAttr_NumConstrs) << " constraints, built in "
+        << to_ns(solve_start - build_start) / 1.0e9 << " s, solved in "
+        << to_ns(get_current_time_fenced() - solve_start) / 1.0e9 << " s, "
+        << callback.added_constraints << " lazy constraints" << std::endl;
+#endif
 
     std::ranges::sort(vertex_order,
                       [this](vertex_t u, vertex_t v) {
@@ -27,28 +151,35 @@ bool ilp_solver::solve() {
     return true;
 }
 
-void ilp_solver::initialise_model(GRBModel& model) {
+void ilp_solver::initialise_model(GRBModel& model, int start_crossing_number) {
     setup_order_variables(model);
-    transitivity_constraints(model);
+    if (options.ilp_transitivity == EAGER_TRANSITIVITY) { transitivity_constraints(model); }
+    symmetry_breaking_constraints(model);
 
-    crossing_upper_bound = model.addVar(0, GRB_INFINITY, 0, GRB_INTEGER, "k");
+    // The crossing number the solver was created with is a known bound (e.g.
+    // of another block), any drawing reaching it is good enough
+    int lower_bound = std::max(crossing_number, local_crossing_lower_bound(graph));
+    GRBVar k = model.addVar(lower_bound, GRB_INFINITY, 0, GRB_INTEGER, "k");
+    k.set(GRB_DoubleAttr_Start, std::max(start_crossing_number, lower_bound));
+    crossing_upper_bound = k;
     setup_crossing_variables(model);
 
-#ifndef ILP_CROSSING_SUM_OPTIMIZATION
-    model.setObjective(crossing_upper_bound, GRB_MINIMIZE);
-#else
+    if (!options.crossing_sum_objective) {
+        model.setObjective(crossing_upper_bound, GRB_MINIMIZE);
+        return;
+    }
     GRBLinExpr crossing_sum = 0;
     for (const GRBLinExpr& edge_sum : edge_crossing_numbers) {
         crossing_sum += edge_sum;
     }
     int factor = boost::num_edges(graph) * boost::num_edges(graph);
     model.setObjective(crossing_upper_bound + crossing_sum / factor, GRB_MINIMIZE);
-#endif
 }
 
 void ilp_solver::setup_order_variables(GRBModel& model) {
     int num_vertices = static_cast<int>(boost::num_vertices(graph));
     order_variables = std::vector<std::vector<GRBLinExpr>>(num_vertices);
+    before_variables.clear();
     for (int i = 0; i < num_vertices; ++i) {
         order_variables[i].resize(num_vertices, 0);
     }
@@ -56,11 +187,14 @@ void ilp_solver::setup_order_variables(GRBModel& model) {
         for (int j = 0; j < num_vertices; ++j) {
             if (i == j) { continue; }
             if (order_variables[j][i].size() == 0) {
-                order_variables[i][j] = model.addVar(
+                GRBVar is_before = model.addVar(
                     0, 1, 0, GRB_BINARY,
                     "is_" + std::to_string(i) +
                     "_before_" + std::to_string(j)
                 );
+                is_before.set(GRB_DoubleAttr_Start, start_positions[i] < start_positions[j]);
+                order_variables[i][j] = is_before;
+                before_variables.push_back(is_before);
             } else {
                 order_variables[i][j] = 1 - order_variables[j][i];
             }
@@ -68,67 +202,85 @@ void ilp_solver::setup_order_variables(GRBModel& model) {
     }
 }
 
+// No directed triangle, one constraint for each orientation of every triangle
 void ilp_solver::transitivity_constraints(GRBModel &model) {
     int num_vertices = static_cast<int>(boost::num_vertices(graph));
-    for (int start = 0; start < num_vertices; ++start) {
-        for (int middle = 0; middle < num_vertices; ++middle) {
-            for (int end = 0; end < num_vertices; ++end) {
-                model.addConstr(
-                    order_variables[start][end] >=
-                    order_variables[start][middle] +
-                    order_variables[middle][end] - 1
-                );
+    for (int first = 0; first < num_vertices; ++first) {
+        for (int second = first + 1; second < num_vertices; ++second) {
+            for (int third = second + 1; third < num_vertices; ++third) {
+                model.addConstr(order_variables[first][second] + order_variables[second][third] +
+                                order_variables[third][first] <= 2);
+                model.addConstr(order_variables[first][third] + order_variables[third][second] +
+                                order_variables[second][first] <= 2);
             }
         }
     }
 }
 
+void ilp_solver::symmetry_breaking_constraints(GRBModel& model) {
+    if (!options.symmetry_breaking) { return; }
+    for (auto [before, after] : symmetries.ordered_pairs(static_cast<int>(boost::num_vertices(graph)))) {
+        model.addConstr(order_variables[before][after] == 1);
+    }
+}
+
 void ilp_solver::setup_crossing_variables(GRBModel& model) {
+    const crossable_pairs_t crossable_pairs(graph);
     edge_crossing_numbers = std::vector<GRBLinExpr>(boost::num_edges(graph));
-    for (edge_t edge1 : make_iterator_range(edges(graph))) {
+    crossing_pairs.clear();
+    crossing_pairs.reserve(crossable_pairs.size());
+    for (int index = 0; index < crossable_pairs.size(); ++index) {
+        auto& [edge1, edge2] = crossable_pairs.edges(index);
         int u = static_cast<int>(get(vertex_index_map, source(edge1, graph)));
         int v = static_cast<int>(get(vertex_index_map, target(edge1, graph)));
-        for (edge_t edge2 : make_iterator_range(edges(graph))) {
-            if (get(edge_index_map, edge1) >= get(edge_index_map, edge2)) {
-                continue;
-            }
-            int s = static_cast<int>(get(vertex_index_map, source(edge2, graph)));
-            int t = static_cast<int>(get(vertex_index_map, target(edge2, graph)));
-
-            GRBVar do_cross = model.addVar(0, 1, 0, GRB_BINARY, "");
-
-            edge_crossing_numbers[get(edge_index_map, edge1)] += do_cross;
-            edge_crossing_numbers[get(edge_index_map, edge2)] += do_cross;
-
-            {
-                model.addConstr(do_cross >= order_variables[u][s] + order_variables[s][v] + order_variables[v][t] - 2);
-                model.addConstr(do_cross >= order_variables[u][t] + order_variables[t][v] + order_variables[v][s] - 2);
-                model.addConstr(do_cross >= order_variables[v][s] + order_variables[s][u] + order_variables[u][t] - 2);
-                model.addConstr(do_cross >= order_variables[v][t] + order_variables[t][u] + order_variables[u][s] - 2);
-                model.addConstr(do_cross >= order_variables[s][u] + order_variables[u][t] + order_variables[t][v] - 2);
-                model.addConstr(do_cross >= order_variables[t][u] + order_variables[u][s] + order_variables[s][v] - 2);
-                model.addConstr(do_cross >= order_variables[s][v] + order_variables[v][t] + order_variables[t][u] - 2);
-                model.addConstr(do_cross >= order_variables[t][v] + order_variables[v][s] + order_variables[s][u] - 2);
-#ifdef ILP_EXACT_CROSS
-                model.addConstr(do_cross <= 3 - order_variables[u][v] - order_variables[v][s] - order_variables[s][t]);
-                model.addConstr(do_cross <= 3 - order_variables[u][s] - order_variables[s][t] - order_variables[t][v]);
-                model.addConstr(do_cross <= 3 - order_variables[s][t] - order_variables[t][u] - order_variables[u][v]);
-                model.addConstr(do_cross <= 3 - order_variables[s][u] - order_variables[u][v] - order_variables[v][t]);
-                model.addConstr(do_cross <= 3 - order_variables[v][u] - order_variables[u][s] - order_variables[s][t]);
-                model.addConstr(do_cross <= 3 - order_variables[v][s] - order_variables[s][t] - order_variables[t][u]);
-                model.addConstr(do_cross <= 3 - order_variables[s][t] - order_variables[t][v] - order_variables[v][u]);
-                model.addConstr(do_cross <= 3 - order_variables[s][v] - order_variables[v][u] - order_variables[u][t]);
-                model.addConstr(do_cross <= 3 - order_variables[u][v] - order_variables[v][t] - order_variables[t][s]);
-                model.addConstr(do_cross <= 3 - order_variables[u][t] - order_variables[t][s] - order_variables[s][v]);
-                model.addConstr(do_cross <= 3 - order_variables[t][s] - order_variables[s][u] - order_variables[u][v]);
-                model.addConstr(do_cross <= 3 - order_variables[t][u] - order_variables[u][v] - order_variables[v][s]);
-                model.addConstr(do_cross <= 3 - order_variables[v][u] - order_variables[u][t] - order_variables[t][s]);
-                model.addConstr(do_cross <= 3 - order_variables[v][t] - order_variables[t][s] - order_variables[s][u]);
-                model.addConstr(do_cross <= 3 - order_variables[t][s] - order_variables[s][v] - order_variables[v][u]);
-                model.addConstr(do_cross <= 3 - order_variables[t][v] - order_variables[v][u] - order_variables[u][s]);
-#endif
+        int s = static_cast<int>(get(vertex_index_map, source(edge2, graph)));
+        int t = static_cast<int>(get(vertex_index_map, target(edge2, graph)));
+
+        GRBVar do_cross = model.addVar(0, 1, 0, GRB_BINARY, "");
+        do_cross.set(GRB_DoubleAttr_Start, chords_cross({start_positions[u], start_positions[v]},
+                                                        {start_positions[s], start_positions[t]}));
+
+        edge_crossing_numbers[get(edge_index_map, edge1)] += do_cross;
+        edge_crossing_numbers[get(edge_index_map, edge2)] += do_cross;
+
+        crossing_pairs.push_back({{u, v, s, t}, do_cross});
+    }
+    for (const GRBLinExpr& edge_crossing_number : edge_crossing_numbers) {
+        model.addConstr(crossing_upper_bound >= edge_crossing_number);
+    }
+    if (options.ilp_crossings == LAZY_CROSSINGS) { return; }
+    if (options.exact_crossings) {
+        crossing_constraints<true>(model);
+    } else {
+        crossing_constraints<false>(model);
+    }
+}
+
+template <bool exact>
+void ilp_solver::crossing_constraints(GRBModel& model) {
+    for (const crossing_pair_t& pair : crossing_pairs) {
+        for (const std::array<int, 4>& pattern : crossing_patterns) {
+            model.addConstr(crossing_constraint(pair, pattern));
+        }
+        if constexpr (exact) {
+            for (const std::array<int, 4>& pattern : non_crossing_patterns) {
+                model.addConstr(non_crossing_constraint(pair, pattern));
             }
         }
-        model.addConstr(crossing_upper_bound >= edge_crossing_numbers[get(edge_index_map, edge1)]);
     }
 }
+
+GRBTempConstr ilp_solver::crossing_constraint(const crossing_pair_t& pair, const std::array<int, 4>& pattern) const {
+    auto [a, b, c, d] = pattern;
+    const auto& ends = pair.ends;
+    return pair.do_cross >= order_variables[ends[a]][ends[b]] + order_variables[ends[b]][ends[c]] +
+        order_variables[ends[c]][ends[d]] - 2;
+}
+
+GRBTempConstr ilp_solver::non_crossing_constraint(const crossing_pair_t& pair,
+                                                  const std::array<int, 4>& pattern) const {
+    auto [a, b, c, d] = pattern;
+    const auto& ends = pair.ends;
+    return pair.do_cross <= 3 - order_variables[ends[a]][ends[b]] - order_variables[ends[b]][ends[c]] -
+        order_variables[ends[c]][ends[d]];
+}
@@ -0,0 +1,43 @@
+#include "incremental_sat_solver.h"
+#include "timer.h"
+
+bool incremental_sat_solver::is_drawable() {
+    if (ipasir_solver == nullptr) {
+        initialise_solver();
+    } else {
+        // The bound of the previous call is replaced by the current one
+        add(-bound_activation);
+        add(0);
+    }
+    bound_activation = ++variable_count;
+    local_crossing_constraint(variable_count, bound_activation);
+    flush();
+    ipasir_assume(ipasir_solver, bound_activation);
+
+    auto start = get_current_time_fenced();
+    int result = ipasir_solve(ipasir_solver);
+    print_statistics(variable_count, to_ns(get_current_time_fenced() - start));
+    switch (result) {
+    case 10:
+        return true;
+    case 20:
+        return false;
+    default:
+        std::cerr << "SAT solver undefined result" << std::endl;
+        return false;
+    }
+}
+
+void incremental_sat_solver::initialise_solver() {
+    ipasir_solver = ipasir_init();
+    // First variable is FALSE
+    add(-false_literal);
+    add(0);
+
+    variable_count = 1;
+
+    setup_order_variables(variable_count);
+    transitivity_constraints();
+    symmetry_breaking_constraints();
+    setup_crossing_variables(variable_count);
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <boost/graph/biconnected_components.hpp>
+#include "lower_bound.h"
+
+namespace {
+    typedef std::vector<std::vector<int>> adjacency_t;
+
+    void add_neighbours(adjacency_t& neighbours, const graph_t& graph, edge_t edge) {
+        int u = static_cast<int>(get(boost::vertex_index, graph, source(edge, graph)));
+        int v = static_cast<int>(get(boost::vertex_index, graph, target(edge, graph)));
+        if (u == v) { return; }
+        neighbours[u].push_back(v);
+        neighbours[v].push_back(u);
+    }
+
+    // Sorts the neighbours and drops parallel edges
+    void normalise(adjacency_t& neighbours) {
+        for (std::vector<int>& vertex_neighbours : neighbours) {
+            std::ranges::sort(vertex_neighbours);
+            vertex_neighbours.erase(std::ranges::unique(vertex_neighbours).begin(), vertex_neighbours.end());
+        }
+    }
+
+    adjacency_t adjacency(const graph_t& graph) {
+        adjacency_t neighbours(num_vertices(graph));
+        for (edge_t edge : make_iterator_range(edges(graph))) { add_neighbours(neighbours, graph, edge); }
+        normalise(neighbours);
+        return neighbours;
+    }
+
+    adjacency_t adjacency(const graph_view_t& graph) {
+        adjacency_t neighbours(graph.num_vertices());
+        for (int v = 0; v < graph.num_vertices(); ++v) {
+            std::ranges::copy_if(graph.neighbours(v), std::back_inserter(neighbours[v]), [v](int u) { return u != v; });
+        }
+        normalise(neighbours);
+        return neighbours;
+    }
+
+    // Vertices in the order of repeatedly removing one of smallest remaining degree
+    std::vector<int> degeneracy_order(const adjacency_t& neighbours) {
+        int num_vertices = static_cast<int>(neighbours.size());
+        std::vector<int> degrees(num_vertices);
+        std::ranges::transform(neighbours, degrees.begin(),
+                               [](const std::vector<int>& adjacent) { return static_cast<int>(adjacent.size()); });
+        std::vector<bool> removed(num_vertices, false);
+        std::vector<int> order;
+        for (int step = 0; step < num_vertices; ++step) {
+            int next = -1;
+            for (int v = 0; v < num_vertices; ++v) {
+                if (!removed[v] && (next < 0 || degrees[v] < degrees[next])) { next = v; }
+            }
+            removed[next] = true;
+            order.push_back(next);
+            for (int u : neighbours[next]) { --degrees[u]; }
+        }
+        return order;
+    }
+
+    int degeneracy(const adjacency_t& neighbours) {
+        std::vector<int> order = degeneracy_order(neighbours);
+        std::vector<int> positions(order.size());
+        for (int i = 0; i < static_cast<int>(order.size()); ++i) { positions[order[i]] = i; }
+        int result = 0;
+        for (int v = 0; v < static_cast<int>(order.size()); ++v) {
+            int later = static_cast<int>(std::ranges::count_if(
+                neighbours[v], [&positions, v](int u) { return positions[u] > positions[v]; }));
+            result = std::max(result, later);
+        }
+        return result;
+    }
+
+    // Bound for n vertices and m edges, see lower_bound.h
+    int density_bound(long long n, long long m) {
+        if (m == 0) { return 0; }
+        long long bound = 0;
+        if (m > 2 * n - 3) { bound = (2 * (m - 2 * n + 3) + m - 1) / m; }
+        if (m >= 3 * n) { bound = std::max(bound, (2 * m * m + 27 * n * n - 1) / (27 * n * n)); }
+        return static_cast<int>(bound);
+    }
+
+    // Largest density bound of the cores of a graph given by its adjacency
+    int core_density_bound(const adjacency_t& neighbours) {
+        std::vector<int> order = degeneracy_order(neighbours);
+        std::vector<bool> removed(neighbours.size(), false);
+        long long num_edges = 0;
+        for (const std::vector<int>& adjacent : neighbours) { num_edges += static_cast<long long>(adjacent.size()); }
+        num_edges /= 2;
+        long long num_vertices = static_cast<long long>(neighbours.size());
+        int result = 0;
+        for (int v : order) {
+            result = std::max(result, density_bound(num_vertices, num_edges));
+            removed[v] = true;
+            --num_vertices;
+            num_edges -= std::ranges::count_if(neighbours[v], [&removed](int u) { return !removed[u]; });
+        }
+        return result;
+    }
+
+    // Bron-Kerbosch with pivoting, only the size of the largest clique is kept
+    void extend_clique(const adjacency_t& neighbours, std::vector<int>& candidates, int size, int& largest) {
+        if (candidates.empty()) {
+            largest = std::max(largest, size);
+            return;
+        }
+        if (size + static_cast<int>(candidates.size()) <= largest) { return; }
+        auto adjacent = [&neighbours](int u, int v) { return std::ranges::binary_search(neighbours[u], v); };
+        int pivot = *std::ranges::max_element(candidates, {}, [&](int u) {
+            return std::ranges::count_if(candidates, [&](int v) { return adjacent(u, v); });
+        });
+        std::vector<int> branches;
+        std::ranges::copy_if(candidates, std::back_inserter(branches), [&](int v) { return !adjacent(pivot, v); });
+        for (int v : branches) {
+            std::vector<int> next;
+            std::ranges::copy_if(candidates, std::back_inserter(next), [&](int u) { return adjacent(v, u); });
+            extend_clique(neighbours, next, size + 1, largest);
+            std::erase(candidates, v);
+        }
+    }
+
+    int degeneracy_bound(const adjacency_t& neighbours) {
+        int d = degeneracy(neighbours);
+        // Smallest k with floor(sqrt(4k + 1)) + 1 >= d
+        return d <= 2 ? 0 : ((d - 1) * (d - 1) - 1 + 3) / 4;
+    }
+
+    int clique_bound(const adjacency_t& neighbours) {
+        std::vector<int> order = degeneracy_order(neighbours);
+        std::vector<int> positions(order.size());
+        for (int i = 0; i < static_cast<int>(order.size()); ++i) { positions[order[i]] = i; }
+
+        // Every clique is found from its first vertex in the degeneracy order
+        int largest = std::min(static_cast<int>(order.size()), 1);
+        for (int v : order) {
+            std::vector<int> candidates;
+            std::ranges::copy_if(neighbours[v], std::back_inserter(candidates),
+                                 [&positions, v](int u) { return positions[u] > positions[v]; });
+            extend_clique(neighbours, candidates, 1, largest);
+        }
+        int half = std::max(largest - 2, 0) / 2;
+        return half * (std::max(largest - 2, 0) - half);
+    }
+}
+
+int degeneracy_lower_bound(const graph_t& graph) {
+    return degeneracy_bound(adjacency(graph));
+}
+
+int clique_lower_bound(const graph_t& graph) {
+    return clique_bound(adjacency(graph));
+}
+
+int density_lower_bound(const graph_t& graph) {
+    typedef boost::property_map<graph_t, boost::edge_index_t>::const_type edge_index_map_t;
+    edge_index_map_t edge_index_map = get(boost::edge_index, graph);
+
+    std::vector<int> edge_component(num_edges(graph));
+    int num_components = static_cast<int>(biconnected_components(
+        graph, make_iterator_property_map(edge_component.begin(), edge_index_map)));
+
+    // Adjacency of every block on the vertices of the whole graph, the
+    // vertices outside of the block are isolated and removed first
+    int result = 0;
+    for (int component = 0; component < num_components; ++component) {
+        adjacency_t neighbours(num_vertices(graph));
+        for (edge_t edge : make_iterator_range(edges(graph))) {
+            if (edge_component[get(edge_index_map, edge)] == component) { add_neighbours(neighbours, graph, edge); }
+        }
+        normalise(neighbours);
+        result = std::max(result, core_density_bound(neighbours));
+    }
+    return result;
+}
+
+int local_crossing_lower_bound(const graph_t& graph) {
+    return std::max({degeneracy_lower_bound(graph), clique_lower_bound(graph), density_lower_bound(graph)});
+}
+
+int local_crossing_lower_bound(const graph_view_t& block) {
+    adjacency_t neighbours = adjacency(block);
+    return std::max({degeneracy_bound(neighbours), clique_bound(neighbours), core_density_bound(neighbours)});
+}
@@ -1,42 +1,188 @@
 #include <boost/property_map/dynamic_property_map.hpp>
 #include <boost/graph/connected_components.hpp>
+#include <fstream>
 #include <iostream>
+#include <map>
 
 #include "okp_recognition.h"
 #include "graphIO.h"
 #include "argument_parser.h"
 #include "timer.h"
+#include "thread_pool.h"
 
-std::unique_ptr<abstract_solver> get_solver(solver_type type, bool use_bct, const graph_t& graph) {
-    switch (type) {
-    case ILP_SOLVER:
+solver_options_t get_solver_options(const command_line_options_t& cmd_arguments, int threads) {
+    solver_options_t options;
+    options.threads = threads;
+    options.dp_arrangements = cmd_arguments.dp_arrangements;
+    options.sat_cardinality = cmd_arguments.sat_cardinality;
+    options.search_strategy = cmd_arguments.search_strategy;
+    options.ilp_transitivity = cmd_arguments.ilp_transitivity;
+    options.ilp_crossings = cmd_arguments.ilp_crossings;
+    options.exact_crossings = cmd_arguments.exact_crossings;
+    options.crossing_sum_objective = cmd_arguments.crossing_sum_objective;
+    options.heuristic_moves = cmd_arguments.heuristic_moves;
+    options.symmetry_breaking = !cmd_arguments.no_symmetry_breaking;
+    return options;
+}
+
+template <class solver_t>
+std::unique_ptr<abstract_solver> make_outer_solver(bool kernelize, bool use_bct, const graph_t& graph,
+                                                   const solver_options_t& options) {
+    if (kernelize) {
         if (!use_bct) {
-            return std::make_unique<ilp_solver>(graph, 0);
+            return std::make_unique<kernelized_solver<solver_t>>(graph, 0, options);
         }
-        return std::make_unique<bicomponent_solver<ilp_solver>>(graph, 0);
+        return std::make_unique<kernelized_solver<bicomponent_solver<solver_t>>>(graph, 0, options);
+    }
+    if (!use_bct) {
+        return std::make_unique<solver_t>(graph, 0, options);
+    }
+    return std::make_unique<bicomponent_solver<solver_t>>(graph, 0, options);
+}
+
+template <class solver_t>
+std::unique_ptr<abstract_solver> make_solver(bool kernelize, bool use_bct, bool split_pairs, const graph_t& graph,
+                                             const solver_options_t& options) {
+    if (split_pairs) {
+        return make_outer_solver<triconnected_solver<solver_t>>(kernelize, use_bct, graph, options);
+    }
+    return make_outer_solver<solver_t>(kernelize, use_bct, graph, options);
+}
+
+std::unique_ptr<abstract_solver> get_solver(solver_type type, bool kernelize, bool use_bct, bool split_pairs,
+                                            const graph_t& graph, const solver_options_t& options) {
+    switch (type) {
+    case ILP_SOLVER:
+        return make_solver<ilp_solver>(kernelize, use_bct, split_pairs, graph, options);
     case SAT_SOLVER:
-        if (!use_bct) {
-            return std::make_unique<sat_solver>(graph, 0);
-        }
-        return std::make_unique<bicomponent_solver<sat_solver>>(graph, 0);
+        return make_solver<sat_solver>(kernelize, use_bct, split_pairs, graph, options);
+    case INCREMENTAL_SAT_SOLVER:
+        return make_solver<incremental_sat_solver>(kernelize, use_bct, split_pairs, graph, options);
     case DP_SOLVER:
-        if (!use_bct) {
-            return std::make_unique<dp_solver>(graph, 0);
-        }
-        return std::make_unique<bicomponent_solver<dp_solver>>(graph, 0);
+        return make_solver<dp_solver>(kernelize, use_bct, split_pairs, graph, options);
+    case HEURISTIC_SOLVER:
+        return make_solver<heuristic_solver>(kernelize, use_bct, split_pairs, graph, options);
     default:
-        return std::make_unique<bicomponent_solver<ilp_solver>>(graph, 0);
+        return make_solver<ilp_solver>(kernelize, use_bct, split_pairs, graph, options);
     }
 }
 
-int main(int ac, char** av) {
-    command_line_options_t cmd_arguments(ac, av);
-    graph_t graph;
-
+boost::dynamic_properties graph_properties(graph_t& graph) {
     boost::dynamic_properties graph_props;
     graph_props.property("node_id", get(&vertex_struct::name, graph));
     graph_props.property("pos", get(&vertex_struct::location, graph));
     graph_props.property("color", get(&edge_struct::color, graph));
+    return graph_props;
+}
+
+void assign_edge_indices(graph_t& graph) {
+    auto edge_index_map = get(boost::edge_index, graph);
+
+    int edge_id = 0;
+    for (auto [ei, ei_end] = edges(graph); ei != ei_end; ++ei) {
+        put(edge_index_map, *ei, edge_id++);
+    }
+}
+
+struct batch_result_t {
+    bool solved = false;
+    int crossing_number = 0;
+    size_t time = 0;
+};
+
+batch_result_t solve_record(const std::string& record, size_t index,
+                            const command_line_options_t& cmd_arguments) {
+    graph_t graph;
+    boost::dynamic_properties graph_props = graph_properties(graph);
+    try {
+        parse_graph_record(record, graph, graph_props);
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: Can not parse graph " << index << ": " << e.what() << std::endl;
+        return {};
+    }
+
+    if (connected_components(graph, boost::dummy_property_map()) != 1) {
+        return {};
+    }
+    assign_edge_indices(graph);
+
+    // The threads of a batch solve different graphs, every solver gets one.
+    // The solver is built inside the try, so a solver failing to start only
+    // fails the line of its graph.
+    batch_result_t result;
+    auto start = get_current_time_fenced();
+    try {
+        std::unique_ptr<abstract_solver> solver = get_solver(cmd_arguments.method, cmd_arguments.kernelize,
+                                                             !cmd_arguments.no_bct_decomposition,
+                                                             cmd_arguments.split_pairs,
+                                                             graph, get_solver_options(cmd_arguments, 1));
+        start = get_current_time_fenced();
+        result.solved = solver->solve();
+        result.crossing_number = solver->crossing_number;
+    } catch (...) {
+        std::cerr << "ERROR: The solver failed on graph " << index << std::endl;
+    }
+    result.time = to_ns(get_current_time_fenced() - start);
+    return result;
+}
+
+int solve_batch(const command_line_options_t& cmd_arguments) {
+    std::ifstream batch_file;
+    if (cmd_arguments.batch_file != "-") {
+        batch_file.open(cmd_arguments.batch_file);
+        if (!batch_file) {
+            std::cerr << "ERROR: Can not open " << cmd_arguments.batch_file << std::endl;
+            return 1;
+        }
+    }
+    std::istream& in = cmd_arguments.batch_file == "-" ? std::cin : batch_file;
+
+    // Every worker builds its own solvers, so kissat instances and Gurobi
+    // models are never shared. Everything expensive to start (e.g. the Gurobi
+    // environment of a worker) lives for the whole batch. The workers pull the
+    // next record from the stream when they are free, so only the graphs being
+    // solved are in memory and the batch can be fed through a pipe. Results
+    // are printed in the input order as soon as all the preceding ones are
+    // known; only those waiting for a preceding one are kept.
+    size_t next_to_read = 0;
+    std::mutex input_mutex;
+    std::map<size_t, batch_result_t> waiting_results;
+    size_t next_to_print = 0;
+    std::mutex print_mutex;
+
+    thread_pool pool(cmd_arguments.threads);
+    pool.parallel_for(pool.size(), [&](size_t, int) {
+        std::string record;
+        while (true) {
+            size_t index;
+            {
+                std::lock_guard lock(input_mutex);
+                if (!read_graph_record(in, record)) { return; }
+                index = next_to_read++;
+            }
+            batch_result_t result = solve_record(record, index, cmd_arguments);
+
+            std::lock_guard lock(print_mutex);
+            waiting_results.emplace(index, result);
+            for (auto ready = waiting_results.begin();
+                 ready != waiting_results.end() && ready->first == next_to_print;
+                 ready = waiting_results.erase(ready), ++next_to_print) {
+                std::cout << next_to_print << " " << ready->second.solved << " " << ready->second.crossing_number
+                    << " " << ready->second.time << std::endl;
+            }
+        }
+    });
+    return 0;
+}
+
+int main(int ac, char** av) {
+    command_line_options_t cmd_arguments(ac, av);
+    if (!cmd_arguments.batch_file.empty()) {
+        return solve_batch(cmd_arguments);
+    }
+
+    graph_t graph;
+    boost::dynamic_properties graph_props = graph_properties(graph);
     read_graphviz(cmd_arguments.input_graph, graph, graph_props);
 
     if (connected_components(graph, boost::dummy_property_map()) != 1) {
@@ -48,14 +194,13 @@ int main(int ac, char** av) {
         return 0;
     }
 
-    auto edge_index_map = get(boost::edge_index, graph);
+    assign_edge_indices(graph);
 
-    int edge_id = 0;
-    for (auto [ei, ei_end] = edges(graph); ei != ei_end; ++ei) {
-        put(edge_index_map, *ei, edge_id++);
-    }
-
-    std::unique_ptr<abstract_solver> solver = get_solver(cmd_arguments.method, !cmd_arguments.no_bct_decomposition, graph);
+    std::unique_ptr<abstract_solver> solver = get_solver(cmd_arguments.method, cmd_arguments.kernelize,
+                                                         !cmd_arguments.no_bct_decomposition,
+                                                         cmd_arguments.split_pairs,
+                                                         graph, get_solver_options(cmd_arguments,
+                                                                                   cmd_arguments.threads));
     auto start = get_current_time_fenced();
     bool solved = solver->solve();
     auto end = get_current_time_fenced();
@@ -63,6 +208,9 @@ int main(int ac, char** av) {
     if (solved) {
         std::cout << "Crossing number: " << solver->crossing_number << std::endl;
         std::cout << "Time elapsed: " << to_ns(end - start) / 1.0e9 << " s" << std::endl;
+        if (solver->oracle_calls > 0) {
+            std::cout << "Oracle calls: " << solver->oracle_calls << std::endl;
+        }
     } else {
         std::cout << "The solver wasn't able to find a solution!" << std::endl;
     }
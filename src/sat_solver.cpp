@@ -1,55 +1,81 @@
+#include "crossing_patterns.h"
+#include "crossing_search.h"
+#include "heuristic_solver.h"
+#include "lower_bound.h"
 #include "sat_solver.h"
+#include "symmetry_breaking.h"
+#include "timer.h"
 
 bool sat_solver::solve() {
-    vertex_order.clear();
-    vertex_order.insert(vertex_order.end(), vertices(graph).first, vertices(graph).second);
+    // The heuristic drawing gives the upper bound, it is replaced by the
+    // model of every satisfiable call
+    int upper_bound = heuristic_drawing(graph, options, vertex_order);
     if (vertex_order.size() <= 3) {
         return true;
     }
 
-    while (!is_drawable()) {
-        crossing_number++;
-    }
-
-    std::ranges::sort(vertex_order,
-                      [this](vertex_t u, vertex_t v) {
-                          int u_idx = static_cast<int>(get(vertex_index_map, u));
-                          int v_idx = static_cast<int>(get(vertex_index_map, v));
-                          return kissat_value(kissat_solver, order_variables[u_idx][v_idx]) > 0;
-                      });
+    int lower_bound = local_crossing_lower_bound(graph);
+    crossing_number = search_crossing_number(options.search_strategy, crossing_number, lower_bound, upper_bound,
+                                             [this](int k) {
+        ++oracle_calls;
+        crossing_number = k;
+        if (!is_drawable()) { return false; }
+        std::ranges::sort(vertex_order,
+                          [this](vertex_t u, vertex_t v) {
+                              int u_idx = static_cast<int>(get(vertex_index_map, u));
+                              int v_idx = static_cast<int>(get(vertex_index_map, v));
+                              return is_true(order_variables[u_idx][v_idx]);
+                          });
+        return true;
+    });
 
     return true;
 }
 
 bool sat_solver::is_drawable() {
-    initialise_solver();
+    int variable_count = initialise_solver();
+    flush();
 
-    switch (kissat_solve(kissat_solver)) {
+    auto start = get_current_time_fenced();
+    int result = kissat_solve(kissat_solver);
+    print_statistics(variable_count, to_ns(get_current_time_fenced() - start));
+    switch (result) {
     case 10:
         return true;
     case 20:
         return false;
     default:
-        std::cout << "SAT solver undefined result" << std::endl;
+        std::cerr << "SAT solver undefined result" << std::endl;
         return false;
     }
 }
 
-void sat_solver::initialise_solver() {
+void sat_solver::print_statistics(int variable_count, size_t solve_time) const {
+#ifndef PERF_TEST
+    std::cerr << "SAT crossing number " << crossing_number << ": " << variable_count << " variables, "
+        << clause_count << " clauses, solved in " << solve_time / 1.0e9 << " s" << std::endl;
+#endif
+}
+
+int sat_solver::initialise_solver() {
     if (kissat_solver != nullptr) { kissat_release(kissat_solver); }
+    clause_count = 0;
+    clause_buffer.clear();
 
     kissat_solver = kissat_init();
     kissat_set_option(kissat_solver, "quiet", 1);
     // First variable is FALSE
-    kissat_add(kissat_solver, -1);
-    kissat_add(kissat_solver, 0);
+    add(-false_literal);
+    add(0);
 
     int variable_count = 1;
 
     setup_order_variables(variable_count);
     transitivity_constraints();
+    symmetry_breaking_constraints();
     setup_crossing_variables(variable_count);
-    local_crossing_constraint();
+    local_crossing_constraint(variable_count);
+    return variable_count;
 }
 
 void sat_solver::setup_order_variables(int& variable_count) {
@@ -74,102 +100,80 @@ void sat_solver::setup_order_variables(int& variable_count) {
     }
 }
 
+// The order is transitive iff it has no directed triangle. Every triangle
+// is forbidden once, a clause for each of its two orientations.
 void sat_solver::transitivity_constraints() {
     int num_vertices = static_cast<int>(boost::num_vertices(graph));
-    for (int start = 0; start < num_vertices; ++start) {
-        for (int middle = 0; middle < num_vertices; ++middle) {
-            for (int end = 0; end < num_vertices; ++end) {
-                kissat_add(kissat_solver, -order_variables[start][middle]);
-                kissat_add(kissat_solver, -order_variables[middle][end]);
-                kissat_add(kissat_solver, order_variables[start][end]);
-                kissat_add(kissat_solver, 0);
+    for (int first = 0; first < num_vertices; ++first) {
+        for (int second = first + 1; second < num_vertices; ++second) {
+            for (int third = second + 1; third < num_vertices; ++third) {
+                add(-order_variables[first][second]);
+                add(-order_variables[second][third]);
+                add(-order_variables[third][first]);
+                add(0);
+                add(-order_variables[first][third]);
+                add(-order_variables[third][second]);
+                add(-order_variables[second][first]);
+                add(0);
             }
         }
     }
 }
 
-void sat_solver::setup_crossing_variables(int& variable_count) {
-    int num_edges = static_cast<int>(boost::num_edges(graph));
-    crossing_variables.resize(num_edges);
-    for (int i = 0; i < num_edges; ++i) {
-        crossing_variables[i].resize(num_edges);
-        std::ranges::fill(crossing_variables[i], 0);
+void sat_solver::symmetry_breaking_constraints() {
+    if (!options.symmetry_breaking) { return; }
+    order_symmetries_t symmetries = find_order_symmetries(graph);
+    for (auto [before, after] : symmetries.ordered_pairs(static_cast<int>(boost::num_vertices(graph)))) {
+        add(order_variables[before][after]);
+        add(0);
     }
+}
 
-    for (edge_t edge1 : make_iterator_range(edges(graph))) {
-        int edge1_idx = get(edge_index_map, edge1);
-        for (edge_t edge2 : make_iterator_range(edges(graph))) {
-            int edge2_idx = get(edge_index_map, edge2);
-            if (edge1_idx == edge2_idx) {
-                crossing_variables[edge1_idx][edge2_idx] = 1;
-            } else if (crossing_variables[edge2_idx][edge1_idx] != 0) {
-                crossing_variables[edge1_idx][edge2_idx] =
-                    crossing_variables[edge2_idx][edge1_idx];
-            } else {
-                crossing_variables[edge1_idx][edge2_idx] = ++variable_count;
-            }
-        }
+void sat_solver::setup_crossing_variables(int& variable_count) {
+    first_crossing_variable = variable_count + 1;
+    variable_count += crossable_pairs.size();
+    // The variant is chosen once, the clauses of every pair come from the specialised emitter
+    auto add_clauses = options.exact_crossings ? &sat_solver::add_crossing_clauses<true>
+                                               : &sat_solver::add_crossing_clauses<false>;
+    for (int pair = 0; pair < crossable_pairs.size(); ++pair) {
+        auto& [edge1, edge2] = crossable_pairs.edges(pair);
+        std::array<int, 4> ends{
+            static_cast<int>(get(vertex_index_map, source(edge1, graph))),
+            static_cast<int>(get(vertex_index_map, target(edge1, graph))),
+            static_cast<int>(get(vertex_index_map, source(edge2, graph))),
+            static_cast<int>(get(vertex_index_map, target(edge2, graph)))
+        };
+        (this->*add_clauses)(ends, first_crossing_variable + pair);
     }
+}
 
-    for (auto [e1i, ei_end] = edges(graph); e1i != ei_end; ++e1i) {
-        int edge1_idx = get(edge_index_map, *e1i);
-        for (auto e2i = std::next(e1i); e2i != ei_end; ++e2i) {
-            int edge2_idx = get(edge_index_map, *e2i);
-            add_crossing_clauses(*e1i, *e2i, crossing_variables[edge1_idx][edge2_idx]);
+template <bool exact>
+void sat_solver::add_crossing_clauses(const std::array<int, 4>& ends, int crossing_var) {
+    for (auto [a, b, c, d] : crossing_patterns) {
+        add(-order_variables[ends[a]][ends[b]]);
+        add(-order_variables[ends[b]][ends[c]]);
+        add(-order_variables[ends[c]][ends[d]]);
+        add(crossing_var);
+        add(0);
+    }
+    if constexpr (exact) {
+        for (auto [a, b, c, d] : non_crossing_patterns) {
+            add(-order_variables[ends[a]][ends[b]]);
+            add(-order_variables[ends[b]][ends[c]]);
+            add(-order_variables[ends[c]][ends[d]]);
+            add(-crossing_var);
+            add(0);
         }
     }
 }
 
-#define ADD_CLAUSE4(solver, a, b, c, d) {kissat_add(solver, a);kissat_add(solver, b);kissat_add(solver, c);kissat_add(solver, d);kissat_add(solver, 0);}
-
-void sat_solver::add_crossing_clauses(const edge_t& edge1, const edge_t& edge2, int crossing_var) const {
-    int u = static_cast<int>(get(vertex_index_map, source(edge1, graph)));
-    int v = static_cast<int>(get(vertex_index_map, target(edge1, graph)));
-    int s = static_cast<int>(get(vertex_index_map, source(edge2, graph)));
-    int t = static_cast<int>(get(vertex_index_map, target(edge2, graph)));
-    ADD_CLAUSE4(kissat_solver, -order_variables[u][s], -order_variables[s][v], -order_variables[v][t], crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[u][t], -order_variables[t][v], -order_variables[v][s], crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[v][s], -order_variables[s][u], -order_variables[u][t], crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[v][t], -order_variables[t][u], -order_variables[u][s], crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[s][u], -order_variables[u][t], -order_variables[t][v], crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[t][u], -order_variables[u][s], -order_variables[s][v], crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[s][v], -order_variables[v][t], -order_variables[t][u], crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[t][v], -order_variables[v][s], -order_variables[s][u], crossing_var)
-
-#ifdef SAT_EXACT_CROSS
-    ADD_CLAUSE4(kissat_solver, -order_variables[u][v], -order_variables[v][s], -order_variables[s][t], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[u][s], -order_variables[s][t], -order_variables[t][v], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[s][t], -order_variables[t][u], -order_variables[u][v], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[s][u], -order_variables[u][v], -order_variables[v][t], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[v][u], -order_variables[u][s], -order_variables[s][t], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[v][s], -order_variables[s][t], -order_variables[t][u], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[s][t], -order_variables[t][v], -order_variables[v][u], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[s][v], -order_variables[v][u], -order_variables[u][t], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[u][v], -order_variables[v][t], -order_variables[t][s], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[u][t], -order_variables[t][s], -order_variables[s][v], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[t][s], -order_variables[s][u], -order_variables[u][v], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[t][u], -order_variables[u][v], -order_variables[v][s], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[v][u], -order_variables[u][t], -order_variables[t][s], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[v][t], -order_variables[t][s], -order_variables[s][u], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[t][s], -order_variables[s][v], -order_variables[v][u], -crossing_var)
-    ADD_CLAUSE4(kissat_solver, -order_variables[t][v], -order_variables[v][u], -order_variables[u][s], -crossing_var)
-#endif
-}
-
-void sat_solver::local_crossing_constraint() {
+void sat_solver::local_crossing_constraint(int& variable_count, int activation) {
+    cardinality_encoder encoder([this](int literal) { add(literal); }, false_literal);
+    std::vector<int> crossings;
     for (edge_t edge : make_iterator_range(edges(graph))) {
-        std::string crossings(crossing_number + 1, 1);
         int edge_idx = get(edge_index_map, edge);
-        crossings.resize(boost::num_edges(graph), 0);
-        do {
-            int i = 0;
-            for (edge_t other : make_iterator_range(edges(graph))) {
-                if (crossings[i++]) {
-                    int other_idx = get(edge_index_map, other);
-                    kissat_add(kissat_solver, -crossing_variables[edge_idx][other_idx]);
-                }
-            }
-            kissat_add(kissat_solver, 0);
-        } while (std::ranges::prev_permutation(crossings).found);
+        crossings.clear();
+        for (int pair : crossable_pairs.pairs_of(edge_idx)) { crossings.push_back(first_crossing_variable + pair); }
+        encoder.at_most(options.sat_cardinality, crossings, crossing_number, activation, variable_count);
     }
 }
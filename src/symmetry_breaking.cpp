@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <map>
+#include "symmetry_breaking.h"
+
+std::vector<std::pair<int, int>> order_symmetries_t::ordered_pairs(int num_vertices) const {
+    std::vector<std::pair<int, int>> pairs;
+    if (first < 0) { return pairs; }
+    for (int v = 0; v < num_vertices; ++v) {
+        if (v != first) { pairs.emplace_back(first, v); }
+    }
+    if (reflection.first >= 0) { pairs.push_back(reflection); }
+    for (const std::vector<int>& twins : twin_classes) {
+        for (size_t i = 0; i + 1 < twins.size(); ++i) { pairs.emplace_back(twins[i], twins[i + 1]); }
+    }
+    return pairs;
+}
+
+void order_symmetries_t::canonicalise(std::vector<vertex_t>& order, const graph_t& graph) const {
+    if (first < 0) { return; }
+    auto index = [&graph](vertex_t v) { return static_cast<int>(get(boost::vertex_index, graph, v)); };
+    std::ranges::rotate(order, std::ranges::find_if(order, [&](vertex_t v) { return index(v) == first; }));
+
+    std::vector<int> position(order.size());
+    auto update_positions = [&] {
+        for (int i = 0; i < static_cast<int>(order.size()); ++i) { position[index(order[i])] = i; }
+    };
+    update_positions();
+    if (reflection.first >= 0 && position[reflection.second] < position[reflection.first]) {
+        std::reverse(order.begin() + 1, order.end());
+        update_positions();
+    }
+
+    // The twins of a class take the places of the class in increasing order
+    for (const std::vector<int>& twins : twin_classes) {
+        std::vector<int> places;
+        for (int v : twins) { places.push_back(position[v]); }
+        std::ranges::sort(places);
+        for (size_t i = 0; i < twins.size(); ++i) { order[places[i]] = boost::vertex(twins[i], graph); }
+    }
+}
+
+order_symmetries_t find_order_symmetries(const graph_t& graph) {
+    order_symmetries_t symmetries;
+    int num_vertices = static_cast<int>(boost::num_vertices(graph));
+    if (num_vertices == 0) { return symmetries; }
+
+    // Twins have the same open (if not adjacent) or closed (if adjacent) neighbourhood
+    std::map<std::vector<int>, std::vector<int>> open_neighbourhoods;
+    std::map<std::vector<int>, std::vector<int>> closed_neighbourhoods;
+    std::vector<int> degree(num_vertices);
+    for (vertex_t v : boost::make_iterator_range(vertices(graph))) {
+        int v_index = static_cast<int>(get(boost::vertex_index, graph, v));
+        std::vector<int> neighbourhood;
+        for (vertex_t u : boost::make_iterator_range(adjacent_vertices(v, graph))) {
+            neighbourhood.push_back(static_cast<int>(get(boost::vertex_index, graph, u)));
+        }
+        degree[v_index] = static_cast<int>(neighbourhood.size());
+        std::ranges::sort(neighbourhood);
+        open_neighbourhoods[neighbourhood].push_back(v_index);
+        neighbourhood.insert(std::ranges::upper_bound(neighbourhood, v_index), v_index);
+        closed_neighbourhoods[neighbourhood].push_back(v_index);
+    }
+    // A vertex can not have twins of both kinds, so the classes are disjoint
+    std::vector<bool> has_twin(num_vertices, false);
+    for (const auto* neighbourhoods : {&open_neighbourhoods, &closed_neighbourhoods}) {
+        for (const auto& [neighbourhood, twins] : *neighbourhoods) {
+            if (twins.size() < 2) { continue; }
+            symmetries.twin_classes.push_back(twins);
+            for (int v : twins) { has_twin[v] = true; }
+        }
+    }
+
+    // The first vertex has the largest degree, if possible one without twins
+    auto by_degree = [&](int u, int v) { return std::make_pair(!has_twin[u], degree[u]) <
+                                                std::make_pair(!has_twin[v], degree[v]); };
+    std::vector<int> all_vertices(num_vertices);
+    for (int v = 0; v < num_vertices; ++v) { all_vertices[v] = v; }
+    symmetries.first = std::ranges::max(all_vertices, by_degree);
+    if (has_twin[symmetries.first]) {
+        for (std::vector<int>& twins : symmetries.twin_classes) { std::erase(twins, symmetries.first); }
+        std::erase_if(symmetries.twin_classes, [](const std::vector<int>& twins) { return twins.size() < 2; });
+    }
+
+    std::vector<int> without_twins;
+    for (int v = 0; v < num_vertices; ++v) {
+        if (v != symmetries.first && !has_twin[v]) { without_twins.push_back(v); }
+    }
+    if (without_twins.size() >= 2) { symmetries.reflection = {without_twins[0], without_twins[1]}; }
+    return symmetries;
+}
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <utility>
+#include "thread_pool.h"
+
+thread_pool::thread_pool(int num_threads) {
+    num_threads = std::max(num_threads, 1);
+    for (int i = 0; i < num_threads; ++i) {
+        queues.push_back(std::make_unique<task_queue_t>());
+    }
+    for (int worker = 1; worker < num_threads; ++worker) {
+        workers.emplace_back(&thread_pool::worker_loop, this, worker);
+    }
+}
+
+thread_pool::~thread_pool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake_condition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void thread_pool::parallel_for(size_t num_tasks, const std::function<void(size_t, int)>& task) {
+    if (workers.empty()) {
+        for (size_t index = 0; index < num_tasks; ++index) {
+            task(index, 0);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard lock(mutex);
+        current_task = &task;
+        task_exception = nullptr;
+        task_failed = false;
+        size_t num_queues = queues.size();
+        for (size_t worker = 0; worker < num_queues; ++worker) {
+            std::lock_guard queue_lock(queues[worker]->mutex);
+            for (size_t index = worker * num_tasks / num_queues;
+                 index < (worker + 1) * num_tasks / num_queues; ++index) {
+                queues[worker]->tasks.push_back(index);
+            }
+        }
+        ++generation;
+    }
+    wake_condition.notify_all();
+
+    run_tasks(0);
+
+    // All the tasks are taken at this point, wait for the ones still running.
+    std::unique_lock lock(mutex);
+    done_condition.wait(lock, [this] { return active_workers == 0; });
+    current_task = nullptr;
+    if (task_exception) { std::rethrow_exception(std::exchange(task_exception, nullptr)); }
+}
+
+void thread_pool::worker_loop(int worker) {
+    size_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock lock(mutex);
+            wake_condition.wait(lock, [&] { return stopping || generation != seen_generation; });
+            if (stopping) { return; }
+            seen_generation = generation;
+            ++active_workers;
+        }
+        run_tasks(worker);
+        {
+            std::lock_guard lock(mutex);
+            --active_workers;
+        }
+        done_condition.notify_all();
+    }
+}
+
+void thread_pool::run_tasks(int worker) {
+    size_t index;
+    while (pop_task(worker, index) || steal_task(worker, index)) {
+        // After a failure the remaining tasks are only taken off the queues
+        if (task_failed) { continue; }
+        try {
+            (*current_task)(index, worker);
+        } catch (...) {
+            std::lock_guard lock(mutex);
+            if (!task_exception) { task_exception = std::current_exception(); }
+            task_failed = true;
+        }
+    }
+}
+
+bool thread_pool::pop_task(int worker, size_t& index) {
+    task_queue_t& queue = *queues[worker];
+    std::lock_guard lock(queue.mutex);
+    if (queue.tasks.empty()) { return false; }
+    index = queue.tasks.front();
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool thread_pool::steal_task(int worker, size_t& index) {
+    int num_queues = size();
+    for (int offset = 1; offset < num_queues; ++offset) {
+        task_queue_t& queue = *queues[(worker + offset) % num_queues];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) { continue; }
+        index = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+    return false;
+}